@@ -0,0 +1,137 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include "static_vector.hpp"
+#include <algorithm>         // std::max
+#include <cstddef>           // std::size_t, std::byte
+#include <memory>            // std::align
+#include <memory_resource>   // std::pmr::memory_resource
+#include <new>               // std::bad_alloc
+#include <vector>            // std::vector
+
+namespace static_vector {
+
+// Bump pointer memory resource. Deallocation does nothing, all memory is given back at once by reset(),
+// which keeps the chunks for the next round, or by the destructor. Since it is a memory_resource, it can
+// also be used with std::pmr containers.
+class arena : public std::pmr::memory_resource {
+  public:
+    explicit arena(std::size_t chunk_size = std::size_t{64} << 10,
+                   std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) :
+            m_chunk_size(chunk_size), m_upstream(upstream) {}
+
+    arena(const arena &) = delete;
+    auto operator=(const arena &) -> arena & = delete;
+
+    ~arena() override {
+        for (const auto &c: m_chunks) {
+            m_upstream->deallocate(c.data, c.size);
+        }
+    }
+
+    // Non-virtual entry point, so that arena_allocator can be inlined.
+    auto bump(std::size_t bytes, std::size_t alignment) -> void * {
+        if (void *ptr = std::align(alignment, bytes, m_cur, m_space)) {
+            m_cur = static_cast<std::byte *>(ptr) + bytes;
+            m_space -= bytes;
+            return ptr;
+        }
+        return bump_next_chunk(bytes, alignment);
+    }
+
+    // All memory handed out before is invalid afterwards, so every vector using it has to be dead.
+    void reset() noexcept {
+        m_current = 0;
+        if (m_chunks.empty()) {
+            m_cur = nullptr;
+            m_space = 0;
+        } else {
+            m_cur = m_chunks.front().data;
+            m_space = m_chunks.front().size;
+        }
+    }
+
+  private:
+    struct chunk {
+        void *data;
+        std::size_t size;
+    };
+
+    auto bump_next_chunk(std::size_t bytes, std::size_t alignment) -> void * {
+        // Chunks that are left at this point are wasted until the next reset.
+        for (++m_current; m_current < m_chunks.size(); ++m_current) {
+            m_cur = m_chunks[m_current].data;
+            m_space = m_chunks[m_current].size;
+            if (void *ptr = std::align(alignment, bytes, m_cur, m_space)) {
+                m_cur = static_cast<std::byte *>(ptr) + bytes;
+                m_space -= bytes;
+                return ptr;
+            }
+        }
+
+        const std::size_t size = std::max(m_chunk_size, bytes + alignment);
+        m_chunks.push_back({m_upstream->allocate(size), size});
+        m_current = m_chunks.size() - 1;
+        m_cur = m_chunks.back().data;
+        m_space = size;
+        return bump(bytes, alignment);
+    }
+
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override {
+        return bump(bytes, alignment);
+    }
+
+    void do_deallocate(void * /* unused */, std::size_t /* unused */, std::size_t /* unused */) override {}
+
+    auto do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool override {
+        return this == &other;
+    }
+
+    const std::size_t m_chunk_size;
+    std::pmr::memory_resource *m_upstream;
+    std::vector<chunk> m_chunks;
+    std::size_t m_current = 0;
+    void *m_cur = nullptr;
+    std::size_t m_space = 0;
+};
+
+// Allocator handing out memory of an arena. Deallocation is a no-op, so many short lived vectors that end
+// together are freed by one arena::reset().
+template<class T>
+struct arena_allocator {
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    arena_allocator(arena &a) noexcept : m_arena(std::addressof(a)) {}
+
+    template<class U>
+    arena_allocator(const arena_allocator<U> &other) noexcept : m_arena(other.m_arena) {}
+
+    T *allocate(size_type n) {
+        return static_cast<T *>(m_arena->bump(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T * /* unused */, size_type /* unused */) noexcept {}
+
+    friend bool operator==(const arena_allocator &lhs, const arena_allocator &rhs) noexcept {
+        return lhs.m_arena == rhs.m_arena;
+    }
+
+    friend bool operator!=(const arena_allocator &lhs, const arena_allocator &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+  private:
+    template<class U>
+    friend struct arena_allocator;
+
+    arena *m_arena;
+};
+
+template<class T>
+using arena_vector = vector<T, arena_allocator<T>>;
+
+}   // namespace static_vector
+
+#endif   // ARENA_HPP
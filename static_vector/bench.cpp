@@ -0,0 +1,99 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "static_vector.hpp"
+#include "arena.hpp"
+
+// Has its own construct, so static_vector::vector falls back to constructing element by element. This
+// is the path all copies took before the bulk copy was added.
+template<class T>
+struct elementwise_allocator : std::allocator<T> {
+    template<class U>
+    struct rebind {
+        using other = elementwise_allocator<U>;
+    };
+
+    template<class U, class... Args>
+    void construct(U *ptr, Args &&... args) {
+        new (ptr) U(std::forward<Args>(args)...);
+    }
+};
+
+// Many small vectors with the same lifetime, like the temporaries of handling a request.
+template<class Alloc>
+auto handle_request(std::size_t request, const Alloc &alloc) -> long {
+    long sum = 0;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        static_vector::vector<long, Alloc> v(4 + (i + request) % 60, static_cast<long>(i), alloc);
+        sum += v.back();
+    }
+    return sum;
+}
+
+template<class Func>
+void measure(const char *name, Func f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << elapsed.count() << " ms\n";
+}
+
+int main() {
+    constexpr std::size_t size = 100'000'000;
+
+    std::vector<float> std_source(size, 1.f);
+    static_vector::vector<float> source(size, 1.f);
+    static_vector::vector<float, elementwise_allocator<float>> elementwise_source(size, 1.f);
+
+    measure("std::vector copy", [&] {
+        std::vector<float> copy(std_source);
+        std::cout << copy.back() << '\n';
+    });
+
+    measure("static_vector copy", [&] {
+        static_vector::vector<float> copy(source);
+        std::cout << copy.back() << '\n';
+    });
+
+    measure("static_vector element-wise copy", [&] {
+        static_vector::vector<float, elementwise_allocator<float>> copy(elementwise_source);
+        std::cout << copy.back() << '\n';
+    });
+
+    measure("static_vector copy assignment", [&] {
+        static_vector::vector<float> copy(size, static_vector::for_overwrite);
+        copy = source;
+        std::cout << copy.back() << '\n';
+    });
+
+    measure("static_vector construction", [&] {
+        static_vector::vector<float> v(size, 2.f);
+        std::cout << v.back() << '\n';
+    });
+
+    measure("static_vector parallel construction", [&] {
+        static_vector::vector<float> v(size, 2.f, static_vector::parallel{});
+        std::cout << v.back() << '\n';
+    });
+
+    constexpr std::size_t requests = 10'000;
+
+    measure("requests with std::allocator", [&] {
+        long sum = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            sum += handle_request(r, std::allocator<long>{});
+        }
+        std::cout << sum << '\n';
+    });
+
+    measure("requests with arena", [&] {
+        static_vector::arena request_arena;
+        long sum = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            sum += handle_request(r, static_vector::arena_allocator<long>{request_arena});
+            request_arena.reset();
+        }
+        std::cout << sum << '\n';
+    });
+}
@@ -0,0 +1,162 @@
+#ifndef MAP_FILE_HPP
+#define MAP_FILE_HPP
+
+#include "static_vector.hpp"
+#include <cerrno>         // errno
+#include <filesystem>     // std::filesystem::path
+#include <new>            // std::bad_alloc
+#include <sstream>        // For constructing error message
+#include <stdexcept>      // std::invalid_argument
+#include <string>         // std::string
+#include <system_error>   // std::system_error
+#include <type_traits>    // std::is_trivially_copyable
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap, madvise
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+namespace static_vector {
+
+enum class map_mode {
+    read_only,       // Writing to the elements is not allowed and crashes
+    copy_on_write,   // Writes only change the private copy of the touched pages, not the file
+};
+
+// Passed to madvise, so the kernel knows how aggressive it should read ahead.
+enum class access_hint {
+    normal,
+    sequential,
+    random,
+    will_need,
+};
+
+// Allocator for memory mapped arrays. Deallocation unmaps them, which also takes care of the destruction
+// since only trivially copyable types can be mapped. Allocations of its own are anonymous mappings, so
+// copies of a mapped vector work as expected.
+template<class T>
+struct mapped_allocator {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be mapped.");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<class U>
+    struct rebind {
+        using other = mapped_allocator<U>;
+    };
+
+    mapped_allocator() = default;
+
+    template<class U>
+    mapped_allocator(const mapped_allocator<U> & /* unused */) noexcept {}
+
+    T *allocate(size_type n) {
+        if (n == 0) {
+            return nullptr;
+        }
+
+        void *ptr = ::mmap(
+            nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T *>(ptr);
+    }
+
+    void deallocate(T *ptr, size_type n) noexcept {
+        if (ptr) {
+            ::munmap(ptr, n * sizeof(T));
+        }
+    }
+
+    friend bool operator==(const mapped_allocator & /* unused */,
+                           const mapped_allocator & /* unused */) noexcept {
+        return true;
+    }
+
+    friend bool operator!=(const mapped_allocator & /* unused */,
+                           const mapped_allocator & /* unused */) noexcept {
+        return false;
+    }
+
+    using is_destroying = void;
+};
+
+template<class T>
+using mapped_vector = vector<T, mapped_allocator<T>>;
+
+namespace detail {
+// Closes the file descriptor when leaving map_file, the mapping stays valid without it.
+struct file_descriptor {
+    int fd;
+
+    explicit file_descriptor(int fd_) noexcept : fd(fd_) {}
+    file_descriptor(const file_descriptor &) = delete;
+    auto operator=(const file_descriptor &) -> file_descriptor & = delete;
+
+    ~file_descriptor() {
+        if (fd != -1) {
+            ::close(fd);
+        }
+    }
+};
+
+inline auto errno_error(const std::string &what) -> std::system_error {
+    return std::system_error{errno, std::generic_category(), what};
+}
+
+inline auto to_advice(access_hint hint) noexcept -> int {
+    switch (hint) {
+        case access_hint::sequential: return MADV_SEQUENTIAL;
+        case access_hint::random: return MADV_RANDOM;
+        case access_hint::will_need: return MADV_WILLNEED;
+        default: return MADV_NORMAL;
+    }
+}
+}   // namespace detail
+
+// Maps the file at path as an array of T without copying it. The file has to consist of a whole number
+// of objects of type T.
+template<class T>
+auto map_file(const std::filesystem::path &path, map_mode mode = map_mode::read_only,
+              access_hint hint = access_hint::normal) -> mapped_vector<T> {
+    const detail::file_descriptor file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file.fd == -1) {
+        throw detail::errno_error("Could not open " + path.string());
+    }
+
+    struct stat status {};
+    if (::fstat(file.fd, &status) == -1) {
+        throw detail::errno_error("Could not stat " + path.string());
+    }
+
+    const auto bytes = static_cast<std::size_t>(status.st_size);
+    if (bytes % sizeof(T) != 0) {
+        std::stringstream mes;
+        mes << "Size " << bytes << " of " << path.string() << " is not a multiple of " << sizeof(T)
+            << '\n';
+        throw std::invalid_argument{mes.str()};
+    }
+
+    if (bytes == 0) {
+        return mapped_vector<T>(nullptr, 0);
+    }
+
+    const int prot = mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int flags = mode == map_mode::read_only ? MAP_SHARED : MAP_PRIVATE;
+    void *ptr = ::mmap(nullptr, bytes, prot, flags, file.fd, 0);
+    if (ptr == MAP_FAILED) {
+        throw detail::errno_error("Could not map " + path.string());
+    }
+
+    // Only a hint, so failure does not matter.
+    ::madvise(ptr, bytes, detail::to_advice(hint));
+
+    return mapped_vector<T>(static_cast<T *>(ptr), bytes / sizeof(T));
+}
+
+}   // namespace static_vector
+
+#endif   // MAP_FILE_HPP
@@ -0,0 +1,455 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include "static_vector.hpp"
+#include <algorithm>    // std::swap_ranges, std::lexicographical_compare
+#include <cstddef>      // std::size_t, std::byte
+#include <functional>   // std::less_equal, std::greater, std::greater_equal
+#include <new>          // std::launder
+
+namespace static_vector {
+
+// A vector with a static size like vector, that stores up to N elements inside the object and only
+// uses the allocator for more elements. Since the inline buffer is part of the object, we cannot
+// delegate to a factory like vector does, instead a failed construction is rolled back in
+// construct_elements. Hence the constructors must not delegate either, since then the destructor would
+// run on top of that.
+template<class T, std::size_t N, class Allocator = std::allocator<T>>
+struct small_vector : private Allocator {   // Empty base optimization for most cases
+    static_assert(N > 0, "Use vector if there should be no inline storage.");
+
+    // BEGIN Typedefs
+    using value_type = T;
+    using allocator_type = Allocator;
+    using allocator_traits = std::allocator_traits<allocator_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = detail::iter_wrap<pointer>;
+    using const_iterator = detail::iter_wrap<const_pointer>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // END Typedefs
+
+    static constexpr size_type inline_capacity = N;
+
+  private:
+    auto allocate_storage() -> pointer {
+        return m_size <= N ? inline_data() : allocator_traits::allocate(*this, m_size);
+    }
+
+    auto inline_data() noexcept -> pointer {
+        return std::launder(reinterpret_cast<pointer>(m_buffer));
+    }
+
+    void deallocate_storage() noexcept {
+        if (!is_inline()) {
+            allocator_traits::deallocate(*this, m_data, m_size);
+        }
+    }
+
+    // Calls init on each position, destroys what was constructed and frees the storage if it throws.
+    template<class Init>
+    void construct_elements(Init init) {
+        pointer cur = m_data;
+        try {
+            for (; cur != m_data + m_size; ++cur) {
+                init(cur);
+            }
+        } catch (...) {
+            while (cur != m_data) {
+                allocator_traits::destroy(*this, --cur);
+            }
+            deallocate_storage();
+            throw;
+        }
+    }
+
+    template<class Iter>
+    void copy_construct(Iter first) {
+        if constexpr (!detail::custom_construct_v<allocator_type, T> &&
+                      detail::bitwise_copyable_v<Iter, T>) {
+            if (m_size != 0) {
+                std::memcpy(m_data, detail::iter_address(first), m_size * sizeof(T));
+            }
+        } else {
+            construct_elements([this, &first](pointer p) {
+                allocator_traits::construct(*this, p, *first);
+                ++first;
+            });
+        }
+    }
+
+    // Moves the elements into p, which has to be uninitialized memory for m_size elements.
+    void move_construct_to(pointer p) {
+        pointer cur = p;
+        try {
+            for (pointer src = m_data; src != m_data + m_size; ++src, ++cur) {
+                allocator_traits::construct(*this, cur, std::move_if_noexcept(*src));
+            }
+        } catch (...) {
+            while (cur != p) {
+                allocator_traits::destroy(*this, --cur);
+            }
+            throw;
+        }
+    }
+
+    // Allocations of a destroying allocator destroy their elements themselves on deallocation.
+    void destroy_elements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            if (detail::destroying_delete_v<allocator_type> && !is_inline()) {
+                return;
+            }
+            for (pointer end = m_data + m_size; end != m_data;) {
+                allocator_traits::destroy(*this, --end);
+            }
+        }
+    }
+
+  public:
+    // BEGIN Constructors
+    small_vector(size_type size, const T &value, const allocator_type &alloc = {}) :
+            Allocator(alloc), m_size(size), m_data(allocate_storage()) {
+        construct_elements([this, &value](pointer p) { allocator_traits::construct(*this, p, value); });
+    }
+
+    // Default-Construction in-place without copy.
+    explicit small_vector(size_type size, const allocator_type &alloc = {}) :
+            Allocator(alloc), m_size(size), m_data(allocate_storage()) {
+        construct_elements([this](pointer p) { allocator_traits::construct(*this, p); });
+    }
+
+    // Default-Construction, trivial types stay uninitialized.
+    small_vector(size_type size, for_overwrite_t /* unused */, const allocator_type &alloc = {}) :
+            Allocator(alloc), m_size(size), m_data(allocate_storage()) {
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            construct_elements([this](pointer p) { allocator_traits::construct(*this, p); });
+        }
+    }
+
+    template<class Iter,
+             class = std::enable_if_t<std::is_base_of_v<
+                 std::input_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>>
+    small_vector(Iter begin, Iter end, const allocator_type &alloc = {}) :
+            Allocator(alloc),
+            m_size(static_cast<size_type>(std::distance(begin, end))),
+            m_data(allocate_storage()) {
+        copy_construct(begin);
+    }
+
+    // Takes ownership of an allocation of len elements, which stays on the heap even if len <= N.
+    template<class _alloc = allocator_type,
+             class = std::enable_if_t<detail::destroying_delete_v<_alloc>>>
+    small_vector(pointer &&ptr, size_type len, const allocator_type &alloc = {}) :
+            Allocator(alloc), m_size(len), m_data(std::exchange(ptr, nullptr)) {}
+    // END Constructors
+
+    // BEGIN Rule of five
+    small_vector(const small_vector &other) :
+            Allocator(other.get_allocator()), m_size(other.m_size), m_data(allocate_storage()) {
+        copy_construct(other.m_data);
+    }
+
+    // Heap storage is stolen, inline elements are moved one by one.
+    small_vector(small_vector &&other) :
+            Allocator(other.get_allocator()),
+            m_size(other.m_size),
+            m_data(other.is_inline() ? inline_data() : std::exchange(other.m_data, nullptr)) {
+        if (is_inline()) {
+            other.move_construct_to(m_data);
+        }
+    }
+
+    ~small_vector() {
+        if (!m_data) {
+            return;
+        }
+
+        destroy_elements();
+        deallocate_storage();
+    }
+
+    auto operator=(const small_vector &other) -> small_vector & {
+        if (this == std::addressof(other)) {
+            return *this;
+        }
+        assert(m_size == other.m_size);
+
+        detail::copy_assign(other.m_data, other.m_data + other.m_size, m_data);
+        return *this;
+    }
+
+    auto operator=(small_vector &&other) -> small_vector & {
+        if (this == std::addressof(other)) {
+            return *this;
+        }
+        assert(m_size == other.m_size);
+
+        if (is_inline() && other.is_inline()) {
+            std::move(other.m_data, other.m_data + m_size, m_data);
+        } else if (!is_inline() && !other.is_inline()) {   // Allocated or released
+            swap_storage(other);
+        } else if (is_inline()) {   // Take the allocation of other, or become empty if it was released
+            destroy_elements();
+            m_data = nullptr;
+            swap_storage(other);
+        } else if (m_data) {   // Adopted allocation with at most N elements
+            std::move(other.m_data, other.m_data + m_size, m_data);
+        } else {   // Released, so the inline buffer is free
+            other.move_construct_to(inline_data());
+            m_data = inline_data();
+        }
+        return *this;
+    }
+    // END Rule of five
+
+    // BEGIN Element Access
+    auto operator[](size_type index) noexcept -> reference {
+        return m_data[index];
+    }
+
+    auto operator[](size_type index) const noexcept -> const_reference {
+        return m_data[index];
+    }
+
+    auto at(size_type index) -> reference {
+        if (index >= m_size || empty()) {
+            std::stringstream mes;
+            mes << "Index " << index << " is not smaller than size " << m_size << '\n';
+            throw std::out_of_range{mes.str()};
+        }
+        return (*this)[index];
+    }
+
+    auto at(size_type index) const -> const_reference {
+        if (index >= m_size || empty()) {
+            std::stringstream mes;
+            mes << "Index " << index << " is not smaller than size " << m_size << '\n';
+            throw std::out_of_range{mes.str()};
+        }
+        return (*this)[index];
+    }
+
+    auto front() -> reference {
+        return (*this)[0];
+    }
+
+    auto front() const -> const_reference {
+        return (*this)[0];
+    }
+
+    auto back() -> reference {
+        return (*this)[m_size - 1];
+    }
+
+    auto back() const -> const_reference {
+        return (*this)[m_size - 1];
+    }
+
+    auto data() noexcept -> pointer {
+        return m_data;
+    }
+
+    auto data() const noexcept -> const_pointer {
+        return m_data;
+    }
+    // END Element Access
+
+    // BEGIN Capacity
+    auto empty() const noexcept -> bool {
+        return m_data == nullptr;
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    // True iff the elements live in the object itself.
+    auto is_inline() const noexcept -> bool {
+        return m_data == reinterpret_cast<const_pointer>(m_buffer);
+    }
+
+    auto get_allocator() const noexcept -> allocator_type {
+        return *this;
+    }
+    // END Capacity
+
+    // BEGIN Iterators
+    auto begin() noexcept -> iterator {
+        return iterator{m_data};
+    }
+
+    auto begin() const noexcept -> const_iterator {
+        return const_iterator{m_data};
+    }
+
+    auto cbegin() const noexcept -> const_iterator {
+        return const_iterator{m_data};
+    }
+
+    auto end() noexcept -> iterator {
+        return iterator{m_data + m_size};
+    }
+
+    auto end() const noexcept -> const_iterator {
+        return const_iterator{m_data + m_size};
+    }
+
+    auto cend() const noexcept -> const_iterator {
+        return const_iterator{m_data + m_size};
+    }
+
+    auto rbegin() noexcept -> reverse_iterator {
+        return reverse_iterator{end()};
+    }
+
+    auto rbegin() const noexcept -> const_reverse_iterator {
+        return const_reverse_iterator{end()};
+    }
+
+    auto crbegin() const noexcept -> const_reverse_iterator {
+        return const_reverse_iterator{end()};
+    }
+
+    auto rend() noexcept -> reverse_iterator {
+        return reverse_iterator{begin()};
+    }
+
+    auto rend() const noexcept -> const_reverse_iterator {
+        return const_reverse_iterator{begin()};
+    }
+
+    auto crend() const noexcept -> const_reverse_iterator {
+        return const_reverse_iterator{begin()};
+    }
+    // END Iterators
+
+    // BEGIN Modifiers
+    // Allocations are swapped, inline elements are swapped or moved one by one.
+    void swap(small_vector &other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                            std::is_nothrow_swappable_v<T>) {
+        assert(m_size == other.m_size);
+
+        if (is_inline() && other.is_inline()) {
+            std::swap_ranges(m_data, m_data + m_size, other.m_data);
+        } else if (!is_inline() && !other.is_inline()) {
+            swap_storage(other);
+        } else if (is_inline()) {
+            swap_mixed(*this, other);
+        } else {
+            swap_mixed(other, *this);
+        }
+    }
+
+    friend void swap(small_vector &lhs, small_vector &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+
+    void assign(const value_type &v) {
+        std::fill(m_data, m_data + m_size, v);
+    }
+
+    template<class Iter,
+             class = std::enable_if_t<std::is_base_of_v<
+                 std::input_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>>
+    void assign(Iter first, Iter last) {
+        assert(static_cast<size_type>(std::distance(first, last)) == size());
+
+        detail::copy_assign(first, last, m_data);
+    }
+
+    void assign(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    // Be careful with this, pointer has to be deallocated with same allocator. Inline elements are
+    // moved to a new allocation first.
+    [[nodiscard]] pointer release() {
+        if (m_data && is_inline()) {
+            pointer p = allocator_traits::allocate(*this, m_size);
+            try {
+                move_construct_to(p);
+            } catch (...) {
+                allocator_traits::deallocate(*this, p, m_size);
+                throw;
+            }
+            destroy_elements();
+            m_data = p;
+        }
+        return std::exchange(m_data, nullptr);
+    }
+
+    template<class... Args>
+    auto construct_at(iterator pos, Args &&... args) -> value_type & {
+        allocator_traits::destroy(*this, pos);
+
+        allocator_traits::construct(*this, pos, std::forward<Args>(args)...);
+        return *pos;
+    }
+
+    template<class... Args>
+    auto construct_at(size_t index, Args &&... args) -> value_type & {
+        return construct_at(m_data + index, std::forward<Args>(args)...);
+    }
+    // END Modifiers
+
+  private:
+    void swap_storage(small_vector &other) noexcept {
+        std::swap(static_cast<allocator_type &>(*this), static_cast<allocator_type &>(other));
+        std::swap(m_data, other.m_data);
+    }
+
+    // Moves the inline elements of in to the inline buffer of out, which gets the storage of in (an
+    // allocation or nothing if it was released).
+    static void swap_mixed(small_vector &in, small_vector &out) {
+        in.move_construct_to(out.inline_data());
+        in.destroy_elements();
+        std::swap(static_cast<allocator_type &>(in), static_cast<allocator_type &>(out));
+        in.m_data = std::exchange(out.m_data, out.inline_data());
+    }
+
+    const size_type m_size;
+    pointer m_data;
+    alignas(T) std::byte m_buffer[N * sizeof(T)];
+};
+
+template<class T, std::size_t N, class Alloc>
+bool operator==(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template<class T, std::size_t N, class Alloc>
+bool operator!=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs) {
+    return !(lhs == rhs);
+}
+
+template<class T, std::size_t N, class Alloc>
+bool operator<(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template<class T, std::size_t N, class Alloc>
+bool operator<=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs) {
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::less_equal<>{});
+}
+
+template<class T, std::size_t N, class Alloc>
+bool operator>(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs) {
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::greater<>{});
+}
+
+template<class T, std::size_t N, class Alloc>
+bool operator>=(const small_vector<T, N, Alloc> &lhs, const small_vector<T, N, Alloc> &rhs) {
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::greater_equal<>{});
+}
+
+}   // namespace static_vector
+
+#endif   // SMALL_VECTOR_HPP
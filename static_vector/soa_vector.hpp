@@ -0,0 +1,301 @@
+#ifndef SOA_VECTOR_HPP
+#define SOA_VECTOR_HPP
+
+#include "static_vector.hpp"
+#include <algorithm>   // std::max, std::copy
+#include <cstddef>     // std::size_t, std::byte
+#include <memory>      // std::align, std::destroy_at
+#include <new>         // placement new
+#include <tuple>       // std::tuple, std::get, std::tie
+#include <utility>     // std::index_sequence, std::exchange
+
+namespace static_vector {
+
+// Non-owning view of one column of a soa_vector. Has begin() and end(), so it can be zipped.
+template<class T>
+struct column_span {
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T *;
+    using reference = T &;
+    using iterator = detail::iter_wrap<pointer>;
+
+    auto operator[](size_type index) const noexcept -> reference {
+        return m_data[index];
+    }
+
+    auto data() const noexcept -> pointer {
+        return m_data;
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    auto begin() const noexcept -> iterator {
+        return iterator{m_data};
+    }
+
+    auto end() const noexcept -> iterator {
+        return iterator{m_data + m_size};
+    }
+
+    pointer m_data;
+    size_type m_size;
+};
+
+// Structure of arrays with a static size. Each of the Fields gets its own column, all columns share one
+// allocation and start at a cache line. The allocator only provides the storage, the elements are
+// constructed with placement new.
+template<class Allocator, class... Fields>
+struct basic_soa_vector : private Allocator {   // Empty base optimization for most cases
+    static_assert(sizeof...(Fields) > 0, "There has to be at least one column.");
+
+    // BEGIN Typedefs
+    using allocator_type = Allocator;
+    using allocator_traits = std::allocator_traits<allocator_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::tuple<Fields &...>;
+    using const_reference = std::tuple<const Fields &...>;
+
+    template<std::size_t I>
+    using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+    // END Typedefs
+
+    static constexpr std::size_t column_alignment = std::max({std::size_t{64}, alignof(Fields)...});
+
+  private:
+    using columns_t = std::tuple<Fields *...>;
+    using indices = std::index_sequence_for<Fields...>;
+
+    static_assert(std::is_same_v<typename allocator_traits::value_type, std::byte>,
+                  "The allocator has to allocate std::byte.");
+
+    static constexpr auto round_up(std::size_t bytes) noexcept -> std::size_t {
+        return (bytes + column_alignment - 1) / column_alignment * column_alignment;
+    }
+
+    // Column I starts at a multiple of column_alignment from the first one, the additional alignment at
+    // the end allows to align the first column in the allocation.
+    static auto storage_size(size_type size) noexcept -> std::size_t {
+        std::size_t bytes = 0;
+        ((bytes = round_up(bytes) + size * sizeof(Fields)), ...);
+        return bytes + column_alignment;
+    }
+
+    template<std::size_t... I>
+    void set_columns(std::index_sequence<I...> /* unused */) noexcept {
+        void *first = m_storage;
+        std::size_t space = storage_size(m_size);
+        auto *base = static_cast<std::byte *>(std::align(column_alignment, 0, first, space));
+
+        std::size_t offset = 0;
+        ((std::get<I>(m_columns) = reinterpret_cast<Fields *>(base + round_up(offset)),
+          offset = round_up(offset) + m_size * sizeof(Fields)),
+         ...);
+    }
+
+    auto allocate_storage() -> std::byte * {
+        return allocator_traits::allocate(*this, storage_size(m_size));
+    }
+
+    template<std::size_t I>
+    void destroy_column(size_type count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<field_t<I>>) {
+            for (auto *end = std::get<I>(m_columns) + count; end != std::get<I>(m_columns);) {
+                std::destroy_at(--end);
+            }
+        }
+    }
+
+    template<std::size_t... I>
+    void destroy_columns(std::index_sequence<I...> /* unused */) noexcept {
+        (destroy_column<I>(m_size), ...);
+    }
+
+    void release() noexcept {
+        if (!m_storage) {
+            return;
+        }
+
+        destroy_columns(indices{});
+        allocator_traits::deallocate(*this, m_storage, storage_size(m_size));
+        m_storage = nullptr;
+    }
+
+    // Calls init(p, index, index_tag) on each position of each column. If it throws, everything that
+    // was constructed is destroyed in reverse order and the storage is freed. This is why the
+    // constructors do not delegate, since a delegating constructor that throws would run the destructor
+    // on top of this.
+    template<std::size_t I = 0, class Init>
+    void construct_columns(Init &init) {
+        if constexpr (I < sizeof...(Fields)) {
+            size_type index = 0;
+            try {
+                for (auto *p = std::get<I>(m_columns); index != m_size; ++p, ++index) {
+                    init(p, index, std::integral_constant<std::size_t, I>{});
+                }
+                construct_columns<I + 1>(init);
+            } catch (...) {
+                destroy_column<I>(index);
+                if constexpr (I == 0) {
+                    allocator_traits::deallocate(*this, m_storage, storage_size(m_size));
+                }
+                throw;
+            }
+        }
+    }
+
+    template<class Init>
+    void construct_all(Init init) {
+        set_columns(indices{});
+        construct_columns(init);
+    }
+
+    template<std::size_t... I>
+    auto get_row(size_type index, std::index_sequence<I...> /* unused */) const noexcept -> reference {
+        return std::tie(std::get<I>(m_columns)[index]...);
+    }
+
+  public:
+    // BEGIN Constructors
+    // Value-Initialization of all columns.
+    explicit basic_soa_vector(size_type size, const allocator_type &alloc = {}) :
+            Allocator(alloc), m_size(size), m_storage(allocate_storage()) {
+        construct_all([](auto *p, size_type /* unused */, auto /* unused */) {
+            ::new (static_cast<void *>(p)) std::remove_pointer_t<decltype(p)>();
+        });
+    }
+
+    // Default-Construction, columns of trivial types stay uninitialized.
+    basic_soa_vector(size_type size, for_overwrite_t /* unused */, const allocator_type &alloc = {}) :
+            Allocator(alloc), m_size(size), m_storage(allocate_storage()) {
+        construct_all([](auto *p, size_type /* unused */, auto /* unused */) {
+            ::new (static_cast<void *>(p)) std::remove_pointer_t<decltype(p)>;
+        });
+    }
+
+    // Every row is a copy of value.
+    basic_soa_vector(size_type size, const std::tuple<Fields...> &value,
+                     const allocator_type &alloc = {}) :
+            Allocator(alloc), m_size(size), m_storage(allocate_storage()) {
+        construct_all([&value](auto *p, size_type /* unused */, auto column) {
+            using field = std::remove_pointer_t<decltype(p)>;
+            ::new (static_cast<void *>(p)) field(std::get<decltype(column)::value>(value));
+        });
+    }
+    // END Constructors
+
+    // BEGIN Rule of five
+    basic_soa_vector(const basic_soa_vector &other) :
+            Allocator(other.get_allocator()), m_size(other.m_size), m_storage(allocate_storage()) {
+        construct_all([&other](auto *p, size_type index, auto column) {
+            using field = std::remove_pointer_t<decltype(p)>;
+            const auto &source = std::get<decltype(column)::value>(other.m_columns)[index];
+            ::new (static_cast<void *>(p)) field(source);
+        });
+    }
+
+    basic_soa_vector(basic_soa_vector &&other) noexcept :
+            Allocator(other.get_allocator()),
+            m_size(other.m_size),
+            m_storage(std::exchange(other.m_storage, nullptr)),
+            m_columns(std::exchange(other.m_columns, columns_t{})) {}
+
+    ~basic_soa_vector() {
+        release();
+    }
+
+    auto operator=(const basic_soa_vector &other) -> basic_soa_vector & {
+        if (this == std::addressof(other)) {
+            return *this;
+        }
+        assert(m_size == other.m_size);
+
+        copy_columns(other, indices{});
+        return *this;
+    }
+
+    auto operator=(basic_soa_vector &&other) noexcept -> basic_soa_vector & {
+        if (this == std::addressof(other)) {
+            return *this;
+        }
+        assert(m_size == other.m_size);
+
+        // Like the move constructor, this leaves other without storage and with null columns.
+        release();
+        static_cast<allocator_type &>(*this) = std::move(static_cast<allocator_type &>(other));
+        m_storage = std::exchange(other.m_storage, nullptr);
+        m_columns = std::exchange(other.m_columns, columns_t{});
+        return *this;
+    }
+    // END Rule of five
+
+    // BEGIN Element Access
+    // Proxy for the row, a tuple of references into each column.
+    auto operator[](size_type index) noexcept -> reference {
+        return get_row(index, indices{});
+    }
+
+    auto operator[](size_type index) const noexcept -> const_reference {
+        return get_row(index, indices{});
+    }
+
+    template<std::size_t I>
+    auto column() noexcept -> column_span<field_t<I>> {
+        return {std::get<I>(m_columns), m_size};
+    }
+
+    template<std::size_t I>
+    auto column() const noexcept -> column_span<const field_t<I>> {
+        return {std::get<I>(m_columns), m_size};
+    }
+
+    // All columns, e.g. for std::apply with zip_iter::zip to iterate over rows.
+    auto columns() noexcept -> std::tuple<column_span<Fields>...> {
+        return std::apply([this](auto *... c) { return std::tuple{column_span<Fields>{c, m_size}...}; },
+                          m_columns);
+    }
+
+    auto columns() const noexcept -> std::tuple<column_span<const Fields>...> {
+        return std::apply(
+            [this](auto *... c) { return std::tuple{column_span<const Fields>{c, m_size}...}; },
+            m_columns);
+    }
+    // END Element Access
+
+    // BEGIN Capacity
+    auto empty() const noexcept -> bool {
+        return m_storage == nullptr;
+    }
+
+    auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    auto get_allocator() const noexcept -> allocator_type {
+        return *this;
+    }
+    // END Capacity
+
+  private:
+    template<std::size_t... I>
+    void copy_columns(const basic_soa_vector &other, std::index_sequence<I...> /* unused */) {
+        (detail::copy_assign(std::get<I>(other.m_columns),
+                             std::get<I>(other.m_columns) + m_size,
+                             std::get<I>(m_columns)),
+         ...);
+    }
+
+    const size_type m_size;
+    std::byte *m_storage;
+    columns_t m_columns;
+};
+
+template<class... Fields>
+using soa_vector = basic_soa_vector<std::allocator<std::byte>, Fields...>;
+
+}   // namespace static_vector
+
+#endif   // SOA_VECTOR_HPP
@@ -11,6 +11,17 @@
 #include <initializer_list>   // std::initializer_list
 #include <memory>             // std::allocator, std::allocator_traits
 #include <iterator>           // std::iterator_traits, std::input_iterator_tag
+#include <cstring>            // std::memcpy, std::memmove
+#include <type_traits>        // std::is_trivially_copyable
+#include <new>                // std::align_val_t
+#include <thread>             // std::thread
+#include <vector>             // std::vector, for the worker threads
+#include <exception>          // std::exception_ptr
+#include <atomic>             // std::atomic
+
+#if defined(__linux__)
+#include <sys/mman.h>   // madvise
+#endif
 
 namespace static_vector {
 
@@ -28,8 +39,181 @@ struct destroying_delete<T, typename T::is_destroying> : std::true_type {};
 
 template<class T>
 constexpr bool destroying_delete_v = destroying_delete<T>::value;
+
+// Type Trait that checks if the allocator brings its own construct. std::allocator is excluded, since
+// its construct (deprecated in C++17) does nothing but placement new.
+template<class Alloc, class T, class = void>
+struct custom_construct : std::false_type {};
+
+template<class Alloc, class T>
+struct custom_construct<Alloc, T,
+                        std::void_t<decltype(std::declval<Alloc &>().construct(
+                            std::declval<T *>(), std::declval<const T &>()))>> :
+        std::bool_constant<!std::is_same_v<Alloc, std::allocator<T>>> {};
+
+template<class Alloc, class T>
+constexpr bool custom_construct_v = custom_construct<Alloc, T>::value;
+
+// Before C++20 there is no way to detect contiguous iterators in general, so we only accept pointers.
+template<class Iter>
+constexpr bool contiguous_iter_v =
+#if defined(__cpp_lib_concepts) && defined(__cpp_lib_to_address)
+    std::contiguous_iterator<Iter>;
+#else
+    std::is_pointer_v<Iter>;
+#endif
+
+template<class Iter>
+constexpr auto iter_address(Iter it) noexcept {
+#if defined(__cpp_lib_concepts) && defined(__cpp_lib_to_address)
+    return std::to_address(it);
+#else
+    return it;
+#endif
+}
+
+// Checks if copying [first, last) of type Iter to an array of T can be done by copying the bytes.
+template<class Iter, class T>
+constexpr bool bitwise_copyable_v =
+    contiguous_iter_v<Iter> && std::is_trivially_copyable_v<T> &&
+    std::is_same_v<std::remove_cv_t<typename std::iterator_traits<Iter>::value_type>, T>;
+
+// Copy assignment to already constructed objects, collapses to one memmove if possible.
+template<class Iter, class T>
+void copy_assign(Iter first, Iter last, T *dest) {
+    if constexpr (bitwise_copyable_v<Iter, T>) {
+        if (first != last) {
+            std::memmove(dest, iter_address(first), std::distance(first, last) * sizeof(T));
+        }
+    } else {
+        std::copy(first, last, dest);
+    }
+}
+
+// Alignment of the arrays handed out by an allocator, opt-in by the allocator.
+template<class Alloc, class T, class = void>
+struct alignment : std::integral_constant<std::size_t, alignof(T)> {};
+
+template<class Alloc, class T>
+struct alignment<Alloc, T, std::void_t<decltype(Alloc::alignment)>> :
+        std::integral_constant<std::size_t, Alloc::alignment> {};
+
+template<class Alloc, class T>
+constexpr std::size_t alignment_v = alignment<Alloc, T>::value;
+
+// Unlike std::assume_aligned, the builtin also accepts nullptr, which data() returns after release().
+template<std::size_t N, class T>
+constexpr auto assume_aligned(T *ptr) noexcept -> T * {
+#if defined(__GNUC__)
+    return static_cast<T *>(__builtin_assume_aligned(ptr, N));
+#elif defined(__cpp_lib_assume_aligned)
+    return ptr ? std::assume_aligned<N>(ptr) : ptr;
+#else
+    return ptr;
+#endif
+}
+
+// Bounds of chunk `chunk` if [0, size) is split into `chunks` contiguous parts of almost equal size.
+inline auto chunk_bounds(std::size_t size, std::size_t chunks, std::size_t chunk) noexcept
+    -> std::pair<std::size_t, std::size_t> {
+    const std::size_t base = size / chunks;
+    const std::size_t rest = size % chunks;
+    const std::size_t first = chunk * base + std::min(chunk, rest);
+    return {first, first + base + (chunk < rest ? 1 : 0)};
+}
+
+inline auto chunk_count(std::size_t size, std::size_t threads) noexcept -> std::size_t {
+    return std::max<std::size_t>(1, std::min(size, threads));
+}
+
+// Calls f(chunk, first, last) for each of the chunks of [0, size), all but the first on a new thread. f
+// must not throw. If a thread cannot be started, its chunk is run on the calling thread instead.
+template<class Func>
+void for_each_chunk(std::size_t size, std::size_t chunks, Func f) noexcept {
+    std::vector<std::thread> workers;
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+        const auto [first, last] = chunk_bounds(size, chunks, chunk);
+        try {
+            workers.emplace_back(f, chunk, first, last);
+        } catch (...) {
+            f(chunk, first, last);
+        }
+    }
+
+    const auto [first, last] = chunk_bounds(size, chunks, 0);
+    f(0, first, last);
+
+    for (auto &worker: workers) {
+        worker.join();
+    }
+}
+
+// Constructs data[0, size) with construct(pointer) on multiple threads. If any construction throws, the
+// other chunks stop early, everything constructed is destroyed with destroy(pointer) and the first
+// exception is rethrown, so the memory is uninitialized again.
+template<class T, class Construct, class Destroy>
+void parallel_construct(T *data, std::size_t size, std::size_t threads, Construct construct,
+                        Destroy destroy) {
+    const std::size_t chunks = chunk_count(size, threads);
+    std::vector<std::size_t> constructed(chunks, 0);
+    std::vector<std::exception_ptr> errors(chunks);
+    std::atomic<bool> failed{false};
+
+    // Failures of other threads are only checked once per block, to keep the inner loop simple.
+    constexpr std::size_t block_size = 4096;
+
+    for_each_chunk(size, chunks, [&](std::size_t chunk, std::size_t first, std::size_t last) noexcept {
+        T *p = data + first;
+        try {
+            while (p != data + last && !failed) {
+                T *block_end = data + std::min(last, static_cast<std::size_t>(p - data) + block_size);
+                for (; p != block_end; ++p) {
+                    construct(p);
+                }
+            }
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+            failed = true;
+        }
+        constructed[chunk] = p - (data + first);
+    });
+
+    if (!failed) {
+        return;
+    }
+
+    for (std::size_t chunk = chunks; chunk != 0;) {
+        --chunk;
+        T *first = data + chunk_bounds(size, chunks, chunk).first;
+        for (T *end = first + constructed[chunk]; end != first;) {
+            destroy(--end);
+        }
+    }
+
+    for (const auto &error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
 }   // namespace detail
 
+// Tag type to request default-initialization instead of value-initialization of the elements. For
+// trivially default constructible types this leaves the memory uninitialized, so it is meant for buffers
+// that are overwritten right after construction anyway.
+struct for_overwrite_t {
+    explicit for_overwrite_t() = default;
+};
+
+inline constexpr for_overwrite_t for_overwrite{};
+
+// Requests that construction, assignment or destruction of the elements is split over multiple threads.
+// This also means that the pages are first touched by the thread that uses them first, which matters on
+// NUMA systems. The allocator's construct and destroy have to be thread safe then.
+struct parallel {
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+};
+
 template<class T, class deleter = std::default_delete<T[]>>
 struct delete_allocator {
     deleter del{};
@@ -58,6 +242,70 @@ struct delete_allocator {
     using is_destroying = void;
 };
 
+inline constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+// Allocator that aligns the whole array to Alignment bytes, e.g. 64 for cache lines and AVX-512 or 4096
+// for pages. With HugePages the array is aligned and padded to whole 2 MiB pages, which on Linux are
+// then advised to be backed by transparent huge pages. The vector exposes the alignment in data().
+template<class T, std::size_t Alignment = 64, bool HugePages = false>
+struct aligned_allocator {
+    static_assert(Alignment >= alignof(T), "Alignment has to be at least the one of the type.");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment has to be a power of two.");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr std::size_t alignment = HugePages ? std::max(Alignment, huge_page_size) : Alignment;
+
+    template<class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment, HugePages>;
+    };
+
+    aligned_allocator() = default;
+
+    template<class U>
+    aligned_allocator(const aligned_allocator<U, Alignment, HugePages> & /* unused */) noexcept {}
+
+    T *allocate(size_type n) {
+        const size_type bytes = allocation_size(n);
+        void *ptr = ::operator new(bytes, std::align_val_t{alignment});
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if constexpr (HugePages) {
+            // Only a hint, the memory is fine without huge pages.
+            ::madvise(ptr, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<T *>(ptr);
+    }
+
+    void deallocate(T *ptr, size_type n) noexcept {
+        ::operator delete(ptr, allocation_size(n), std::align_val_t{alignment});
+    }
+
+    friend bool operator==(const aligned_allocator & /* unused */,
+                           const aligned_allocator & /* unused */) noexcept {
+        return true;
+    }
+
+    friend bool operator!=(const aligned_allocator & /* unused */,
+                           const aligned_allocator & /* unused */) noexcept {
+        return false;
+    }
+
+  private:
+    static constexpr auto allocation_size(size_type n) noexcept -> size_type {
+        const size_type bytes = n * sizeof(T);
+        if constexpr (HugePages) {
+            return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+        } else {
+            return bytes;
+        }
+    }
+};
+
 template<class T, class Allocator = std::allocator<T>>
 struct vector : private Allocator {   // Empty base optimization for most cases
 
@@ -77,6 +325,9 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     // END Typedefs
 
+    // Guaranteed alignment of data(), allocators can raise it by a static member alignment.
+    static constexpr std::size_t alignment = detail::alignment_v<allocator_type, T>;
+
   private:
     vector(const allocator_type &alloc, size_type size, pointer p) noexcept :
             Allocator(alloc), m_size(size), m_data(p) {}
@@ -95,8 +346,18 @@ struct vector : private Allocator {   // Empty base optimization for most cases
         template<class Iter>
         vector_factory(allocator_type alloc, Iter first, Iter last) :
                 vector_factory(alloc, std::distance(first, last)) {
-            for (auto it = first; it != last; ++it, ++m_end) {
-                allocator_traits::construct(alloc, m_end, *it);
+            if constexpr (detail::custom_construct_v<allocator_type, T>) {
+                for (auto it = first; it != last; ++it, ++m_end) {
+                    allocator_traits::construct(alloc, m_end, *it);
+                }
+            } else if constexpr (detail::bitwise_copyable_v<Iter, T>) {
+                if (m_size != 0) {
+                    std::memcpy(m_data, detail::iter_address(first), m_size * sizeof(T));
+                }
+                m_end = m_data + m_size;
+            } else {
+                // Cleans up after itself if a constructor throws, so m_end is still m_data then.
+                m_end = std::uninitialized_copy(first, last, m_data);
             }
         }
 
@@ -107,6 +368,57 @@ struct vector : private Allocator {   // Empty base optimization for most cases
             }
         }
 
+        // Calls construct(alloc, pointer, index) on each element on multiple threads.
+        template<class Construct>
+        vector_factory(allocator_type alloc, size_type size, parallel par, Construct construct) :
+                vector_factory(alloc, size) {
+            detail::parallel_construct(
+                m_data,
+                m_size,
+                par.threads,
+                [this, &alloc, &construct](pointer p) { construct(alloc, p, p - m_data); },
+                [&alloc](pointer p) { allocator_traits::destroy(alloc, p); });
+            m_end = m_data + m_size;
+        }
+
+        // Copies [first, first + size) on multiple threads, with one memcpy per chunk where the
+        // sequential copy would use memcpy as well.
+        vector_factory(allocator_type alloc, const_pointer first, size_type size, parallel par) :
+                vector_factory(alloc, size) {
+            if constexpr (!detail::custom_construct_v<allocator_type, T> &&
+                          detail::bitwise_copyable_v<const_pointer, T>) {
+                auto copy_chunk = [this, first](std::size_t /* unused */, std::size_t begin,
+                                                std::size_t end) noexcept {
+                    if (begin != end) {
+                        std::memcpy(m_data + begin, first + begin, (end - begin) * sizeof(T));
+                    }
+                };
+                detail::for_each_chunk(m_size, detail::chunk_count(m_size, par.threads), copy_chunk);
+            } else {
+                detail::parallel_construct(
+                    m_data,
+                    m_size,
+                    par.threads,
+                    [this, &alloc, first](pointer p) {
+                        allocator_traits::construct(alloc, p, first[p - m_data]);
+                    },
+                    [&alloc](pointer p) { allocator_traits::destroy(alloc, p); });
+            }
+            m_end = m_data + m_size;
+        }
+
+        // No loop at all for trivial types, their lifetime begins with the allocation.
+        vector_factory(allocator_type alloc, size_type size, for_overwrite_t /* unused */) :
+                vector_factory(alloc, size) {
+            if constexpr (std::is_trivially_default_constructible_v<T>) {
+                m_end = m_data + m_size;
+            } else {
+                for (; m_end != m_data + m_size; ++m_end) {
+                    allocator_traits::construct(alloc, m_end);
+                }
+            }
+        }
+
         vector_factory(allocator_type alloc, size_type size, const T &t) : vector_factory(alloc, size) {
             for (; m_end != m_data + m_size; ++m_end) {
                 allocator_traits::construct(alloc, m_end, t);
@@ -125,7 +437,7 @@ struct vector : private Allocator {   // Empty base optimization for most cases
                 }
             }
 
-            allocator_traits::deallocate(m_alloc, m_data, std::distance(m_data, m_end));
+            allocator_traits::deallocate(m_alloc, m_data, m_size);
         }
     };
 
@@ -153,6 +465,24 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     explicit vector(size_type size, const allocator_type &alloc = {}) :
             vector(vector_factory(alloc, size, std::in_place_t{})) {}
 
+    // Default-Construction, trivial types stay uninitialized. Use this if you overwrite all elements
+    // anyway, e.g. when reading into data() from a file or socket.
+    vector(size_type size, for_overwrite_t tag, const allocator_type &alloc = {}) :
+            vector(vector_factory(alloc, size, tag)) {}
+
+    // Same as above, but the elements are constructed on par.threads threads.
+    vector(size_type size, const T &value, parallel par, const allocator_type &alloc = {}) :
+            vector(vector_factory(
+                alloc, size, par, [&value](allocator_type &a, pointer p, difference_type /* unused */) {
+                    allocator_traits::construct(a, p, value);
+                })) {}
+
+    vector(size_type size, parallel par, const allocator_type &alloc = {}) :
+            vector(vector_factory(
+                alloc, size, par, [](allocator_type &a, pointer p, difference_type /* unused */) {
+                    allocator_traits::construct(a, p);
+                })) {}
+
     template<class Iter,
              class = std::enable_if_t<std::is_base_of_v<
                  std::input_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>>
@@ -167,7 +497,11 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     // END Constructors
 
     // BEGIN Rule of five
-    vector(const vector &other) : vector(begin(other), end(other), other) {}
+    vector(const vector &other) :
+            vector(vector_factory(other.get_allocator(), other.m_data, other.m_data + other.m_size)) {}
+
+    vector(const vector &other, parallel par) :
+            vector(vector_factory(other.get_allocator(), other.m_data, other.m_size, par)) {}
 
     vector(vector &&other) :
             vector(std::exchange(other.m_data, nullptr), other.m_size, static_cast<std::remove_reference_t<allocator_type>&&>(other)) {}
@@ -192,7 +526,7 @@ struct vector : private Allocator {   // Empty base optimization for most cases
         }
         assert(m_size == other.m_size);
 
-        std::copy(begin(other), end(other), begin(*this));
+        detail::copy_assign(other.m_data, other.m_data + other.m_size, m_data);
         return *this;
     }
 
@@ -251,11 +585,11 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     }
 
     auto data() noexcept -> pointer {
-        return m_data;
+        return detail::assume_aligned<alignment>(m_data);
     }
 
     auto data() const noexcept -> const_pointer {
-        return m_data;
+        return detail::assume_aligned<alignment>(m_data);
     }
     // END Element Access
 
@@ -278,7 +612,7 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     }
 
     auto begin() const noexcept -> const_iterator {
-        return std::cbegin(*this);
+        return const_iterator{m_data};
     }
 
     auto cbegin() const noexcept -> const_iterator {
@@ -290,7 +624,7 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     }
 
     auto end() const noexcept -> const_iterator {
-        return std::cend(*this);
+        return const_iterator{m_data + m_size};
     }
 
     auto cend() const noexcept -> const_iterator {
@@ -333,20 +667,44 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     }
 
     void assign(const value_type &v) {
-        std::fill(begin(*this), end(*this), v);
+        std::fill(m_data, m_data + m_size, v);
+    }
+
+    // v is copied first, since it may be an element that another thread assigns to. If an assignment
+    // throws, the other chunks are still assigned and the first exception is rethrown after all threads
+    // joined. As with the sequential assign, the elements are valid but only partly assigned then.
+    void assign(const value_type &v, parallel par) {
+        const value_type value = v;
+        const std::size_t chunks = detail::chunk_count(m_size, par.threads);
+        std::vector<std::exception_ptr> errors(chunks);
+        auto fill_chunk = [this, &value, &errors](std::size_t chunk, std::size_t first,
+                                                  std::size_t last) noexcept {
+            try {
+                std::fill(m_data + first, m_data + last, value);
+            } catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        };
+        detail::for_each_chunk(m_size, chunks, fill_chunk);
+
+        for (const auto &error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
     }
 
     template<class Iter,
              class = std::enable_if_t<std::is_base_of_v<
                  std::input_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>>
-    void assign(Iter begin, Iter end) {
-        assert(std::distance(begin, end) == size());
+    void assign(Iter first, Iter last) {
+        assert(static_cast<size_type>(std::distance(first, last)) == size());
 
-        std::copy(begin, end, begin(*this));
+        detail::copy_assign(first, last, m_data);
     }
 
     void assign(std::initializer_list<T> ilist) {
-        assign(begin(ilist), end(ilist));
+        assign(ilist.begin(), ilist.end());
     }
 
     void assign(pointer &&p) {
@@ -355,6 +713,25 @@ struct vector : private Allocator {   // Empty base optimization for most cases
         m_data = p;
     }
 
+    // Destroys the elements on multiple threads and deallocates, the vector is empty afterwards.
+    void destroy(parallel par) noexcept {
+        if (!m_data) {
+            return;
+        }
+
+        if constexpr (!detail::destroying_delete_v<allocator_type> &&
+                      !std::is_trivially_destructible_v<T>) {
+            auto destroy_chunk = [this](std::size_t /* unused */, std::size_t first,
+                                        std::size_t last) noexcept {
+                for (pointer end = m_data + last; end != m_data + first;) {
+                    allocator_traits::destroy(*this, --end);
+                }
+            };
+            detail::for_each_chunk(m_size, detail::chunk_count(m_size, par.threads), destroy_chunk);
+        }
+        allocator_traits::deallocate(*this, std::exchange(m_data, nullptr), m_size);
+    }
+
     // Be careful with this, pointer has to be deallocated with same allocator
     [[nodiscard]] pointer release() {
         return std::exchange(m_data, nullptr);
@@ -379,6 +756,12 @@ struct vector : private Allocator {   // Empty base optimization for most cases
     pointer m_data;
 };
 
+// Allocates a vector whose elements are meant to be filled afterwards through data() or the iterators.
+template<class T, class Alloc = std::allocator<T>>
+auto make_vector_for_overwrite(std::size_t size, const Alloc &alloc = {}) -> vector<T, Alloc> {
+    return vector<T, Alloc>(size, for_overwrite, alloc);
+}
+
 template<class T, class Alloc>
 bool operator==(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs) {
     return std::equal(begin(lhs), end(lhs), begin(rhs), end(rhs));
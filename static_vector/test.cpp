@@ -1,5 +1,18 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
 #include "static_vector.hpp"
+#include "map_file.hpp"
+#include "arena.hpp"
+#include "small_vector.hpp"
+#include "soa_vector.hpp"
+#include "../zip/zip.hpp"
 using namespace static_vector;
 
 struct test {
@@ -13,6 +26,55 @@ struct throwing {
     }
 };
 
+// Throws on every third copy, the string makes leaks and double destructions visible.
+struct copy_throwing {
+    std::string payload = "long enough to be allocated on the heap";
+
+    copy_throwing() = default;
+
+    copy_throwing(const copy_throwing &other) : payload(other.payload) {
+        if (++copies % 3 == 0) {
+            throw std::runtime_error("Testing");
+        }
+    }
+
+    static inline int copies = 0;
+};
+
+// Assigning a negative value throws
+struct assign_throwing {
+    int value = 0;
+
+    assign_throwing() = default;
+    assign_throwing(int v) : value(v) {}
+    assign_throwing(const assign_throwing &) = default;
+
+    auto operator=(const assign_throwing &other) -> assign_throwing & {
+        if (other.value < 0) {
+            throw std::runtime_error("Testing");
+        }
+        value = other.value;
+        return *this;
+    }
+};
+
+// Throws on the 500th construction and counts the living objects
+std::atomic<int> living{0};
+std::atomic<int> constructed{0};
+
+struct counted {
+    counted() {
+        if (++constructed == 500) {
+            throw std::runtime_error("Testing");
+        }
+        ++living;
+    }
+
+    ~counted() {
+        --living;
+    }
+};
+
 // Allocating old-style function
 int* create_array(size_t s) {
     return new int[s];
@@ -41,9 +103,185 @@ int main() {
     destroy_array(a.release());
 
 
+    // Trivial types are left uninitialized, others still get constructed
+    vector<double> buffer(1024, for_overwrite);
+    std::fill(std::begin(buffer), std::end(buffer), 1.5);
+    assert(buffer.back() == 1.5);
+
+    auto strings = make_vector_for_overwrite<std::string>(3);
+    assert(strings[2].empty());
+
+    // Copying takes the bitwise fast path for trivial types and the element-wise one otherwise
+    vector<double> buffer_copy(buffer);
+    assert(buffer_copy == buffer);
+    buffer_copy.assign(2.5);
+    buffer = buffer_copy;
+    assert(buffer.front() == 2.5);
+
+    std::string names[] = {"a", "b", "c"};
+    vector<std::string> strings_copy(std::begin(names), std::end(names));
+    strings = strings_copy;
+    assert(strings[1] == "b");
+
+    strings.assign({"x", "y", "z"});
+    assert(strings.back() == "z");
+
+    vector<float, aligned_allocator<float>> simd_buffer(100, 1.f);
+    static_assert(decltype(simd_buffer)::alignment == 64);
+    assert(reinterpret_cast<std::uintptr_t>(simd_buffer.data()) % 64 == 0);
+
+    vector<float, aligned_allocator<float, 4096, true>> huge_buffer(1000, for_overwrite);
+    assert(reinterpret_cast<std::uintptr_t>(huge_buffer.data()) % huge_page_size == 0);
+
+    const auto path = std::filesystem::temp_directory_path() / "static_vector_test.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size() * sizeof(double));
+    }
+
+    auto mapped = map_file<double>(path, map_mode::copy_on_write, access_hint::sequential);
+    assert(mapped.size() == buffer.size() && mapped.back() == 2.5);
+    mapped[0] = 0.;
+    auto mapped_copy = mapped;
+    assert(mapped_copy.front() == 0.);
+    assert(map_file<double>(path).front() == 2.5);   // Does not write through
+
+    try {
+        auto wrong_size = map_file<char[3]>(path);
+        assert(false);
+    } catch (const std::invalid_argument &) {
+    }
+    std::filesystem::remove(path);
+
+    arena request_arena(256);
+    for (int round = 0; round < 2; ++round) {
+        arena_vector<int> small(10, 1, request_arena);
+        arena_vector<std::string> large(100, "text", request_arena);
+        arena_vector<double> aligned_copy(std::begin(buffer), std::end(buffer), request_arena);
+        assert(small.back() == 1 && large.back() == "text" && aligned_copy.back() == 2.5);
+        assert(reinterpret_cast<std::uintptr_t>(aligned_copy.data()) % alignof(double) == 0);
+    }
+    request_arena.reset();
+
+    small_vector<std::string, 4> tiny(3, "tiny");
+    small_vector<std::string, 4> tiny_copy(tiny);
+    small_vector<std::string, 2> spilled(std::begin(names), std::end(names));
+    small_vector<std::string, 4> large_small(10, "large");
+    assert(tiny.is_inline() && !large_small.is_inline() && !spilled.is_inline());
+    assert(tiny == tiny_copy && tiny.at(2) == "tiny");
+
+    auto moved_large = std::move(large_small);
+    assert(large_small.empty() && moved_large.back() == "large");
+    tiny_copy.construct_at(tiny_copy.begin(), "changed");
+    tiny = std::move(tiny_copy);
+    assert(tiny.front() == "changed" && *tiny.rbegin() == "tiny");
+
+    std::allocator<std::string> string_alloc;
+    std::string *released = tiny.release();
+    assert(tiny.empty() && released[0] == "changed");
+    std::destroy_n(released, 3);
+    string_alloc.deallocate(released, 3);
+
+    small_vector<int, 16> ints(16, for_overwrite);
+    std::fill(ints.begin(), ints.end(), 3);
+    small_vector<int, 16> ints_copy(ints);
+    assert(ints_copy.back() == 3);
+
+    // Swapping and comparing, inline and allocated
+    small_vector<std::string, 4> other_tiny(3, "other");
+    swap(tiny_copy, other_tiny);
+    assert(tiny_copy.front() == "other" && other_tiny.size() == 3);
+    small_vector<std::string, 4> other_large(10, "other");
+    moved_large.swap(other_large);
+    assert(moved_large.front() == "other" && other_large.front() == "large");
+    assert(other_large < moved_large && other_large <= moved_large);
+    assert(moved_large > other_large && moved_large >= other_large && moved_large >= moved_large);
+
+    // Moving into a released vector uses its inline buffer again
+    tiny = std::move(tiny_copy);
+    assert(tiny.is_inline() && tiny.front() == "other");
+
+    small_vector<int, 4, delete_allocator<int>> adopted(new int[3]{1, 2, 3}, 3);
+    small_vector<int, 4, delete_allocator<int>> inline_ints(3, 4);
+    assert(!adopted.is_inline() && adopted.back() == 3);
+    adopted = std::move(inline_ints);
+    assert(adopted.back() == 4);
+
+    // A throwing copy is rolled back once, for inline and allocated storage
+    std::vector<copy_throwing> originals(5);
+    for (std::size_t count: {2, 5}) {
+        copy_throwing::copies = 0;
+        try {
+            small_vector<copy_throwing, 2> copies(originals.begin(), originals.begin() + count);
+            small_vector<copy_throwing, 2> copy_of_copies(copies);
+            assert(false);
+        } catch (const std::runtime_error &) {
+        }
+    }
+
+    soa_vector<int, double, std::string> records(100, std::tuple{1, 0.5, std::string{"record"}});
+    auto [ids, weights, labels] = records.columns();
+    assert(reinterpret_cast<std::uintptr_t>(weights.data()) % soa_vector<int>::column_alignment == 0);
+    assert(labels[99] == "record");
+    std::get<0>(records[3]) = 3;
+    for (auto [id, weight]: zip_iter::zip(ids, weights)) {
+        weight *= id;
+    }
+    assert(records.column<1>()[3] == 1.5 && std::get<1>(records[2]) == 0.5);
+
+    auto records_copy = records;
+    records_copy = std::move(records);
+    assert(records_copy.column<0>()[3] == 3 && std::get<2>(records_copy[0]) == "record");
+    assert(records.column<0>().data() == nullptr && records.column<2>().data() == nullptr);
+    auto moved_records = std::move(records_copy);
+    assert(records_copy.column<1>().data() == nullptr && moved_records.column<2>()[99] == "record");
+
+    vector<std::string> parallel_strings(1000, "parallel", parallel{4});
+    vector<std::string> parallel_copy(parallel_strings, parallel{3});
+    assert(parallel_copy == parallel_strings && parallel_copy[999] == "parallel");
+    parallel_copy.assign("assigned", parallel{8});
+    assert(parallel_copy.front() == "assigned" && parallel_copy.back() == "assigned");
+    parallel_copy[500] = "element";
+    parallel_copy.assign(parallel_copy[500], parallel{8});
+    assert(parallel_copy.front() == "element" && parallel_copy.back() == "element");
+    parallel_copy.destroy(parallel{});
+    assert(parallel_copy.empty());
+    vector<double> parallel_doubles(3, parallel{16});
+    assert(parallel_doubles[2] == 0.);
+    parallel_doubles[1] = 1.5;
+    vector<double> parallel_doubles_copy(parallel_doubles, parallel{2});
+    assert(parallel_doubles_copy == parallel_doubles && parallel_doubles_copy[1] == 1.5);
+    vector<double> empty_doubles(0);
+    assert(vector<double>(empty_doubles, parallel{4}).size() == 0);
+
     try {
         // Should not leak
         vector<throwing> t(10);
     } catch (...) {
     }
+
+    vector<assign_throwing> assigned(100, parallel{4});
+    try {
+        assigned.assign(assign_throwing{-1}, parallel{4});
+        assert(false);
+    } catch (const std::runtime_error &) {
+        assert(assigned[0].value == 0 && assigned[99].value == 0);
+    }
+
+    try {
+        vector<counted> t(1000, parallel{4});
+        assert(false);
+    } catch (...) {
+        assert(living == 0);
+    }
+
+    try {
+        small_vector<throwing, 4> t(2);
+    } catch (...) {
+    }
+
+    try {
+        soa_vector<std::string, throwing> t(10);
+    } catch (...) {
+    }
 }
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "struct_iter.hpp"
+
+// Read after each repetition, so the compiler cannot merge the repetitions into one pass.
+volatile double sink;
+
+struct channels {
+    double c0, c1, c2, c3, c4, c5, c6, c7;
+};
+
+// All members in order of declaration, accessed with a stride.
+using strided =
+    struct_it<channels, double, &channels::c0, &channels::c1, &channels::c2, &channels::c3,
+              &channels::c4, &channels::c5, &channels::c6, &channels::c7>;
+
+// Same members in reverse order, accessed through the table of member pointers.
+using table =
+    struct_it<channels, double, &channels::c7, &channels::c6, &channels::c5, &channels::c4,
+              &channels::c3, &channels::c2, &channels::c1, &channels::c0>;
+
+template<class Iter>
+struct fields {
+    Iter begin() {
+        return Iter{c};
+    }
+
+    Iter end() {
+        return Iter::make_end(c);
+    }
+
+    channels &c;
+};
+
+template<class Func>
+void measure(const char *name, Func f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << elapsed.count() << " ms\n";
+}
+
+template<class Iter>
+void sum_fields(const char *name, std::vector<channels> &data, int repetitions) {
+    measure(name, [&] {
+        for (int r = 0; r < repetitions; ++r) {
+            double total = 0;
+            for (auto &c: data) {
+                fields<Iter> f{c};
+                total += std::accumulate(f.begin(), f.end(), 0.);
+            }
+            sink = total;
+        }
+    });
+}
+
+template<class Iter>
+void scale_fields(const char *name, std::vector<channels> &data, int repetitions) {
+    measure(name, [&] {
+        for (int r = 0; r < repetitions; ++r) {
+            for (auto &c: data) {
+                for (double &d: fields<Iter>{c}) {
+                    d *= 1.0000001;
+                }
+            }
+            sink = data[0].c0;
+        }
+    });
+}
+
+int main() {
+    constexpr std::size_t size = 4'096;   // 256 KiB, stays in the cache
+    constexpr int repetitions = 10'000;
+
+    std::vector<channels> data(size, channels{1, 2, 3, 4, 5, 6, 7, 8});
+
+    measure("sum, manual", [&] {
+        for (int r = 0; r < repetitions; ++r) {
+            double total = 0;
+            for (auto &c: data) {
+                total += c.c0 + c.c1 + c.c2 + c.c3 + c.c4 + c.c5 + c.c6 + c.c7;
+            }
+            sink = total;
+        }
+    });
+    sum_fields<strided>("sum, struct_it strided", data, repetitions);
+    sum_fields<table>("sum, struct_it member pointers", data, repetitions);
+
+    measure("scale, manual", [&] {
+        for (int r = 0; r < repetitions; ++r) {
+            for (auto &c: data) {
+                c.c0 *= 1.0000001;
+                c.c1 *= 1.0000001;
+                c.c2 *= 1.0000001;
+                c.c3 *= 1.0000001;
+                c.c4 *= 1.0000001;
+                c.c5 *= 1.0000001;
+                c.c6 *= 1.0000001;
+                c.c7 *= 1.0000001;
+            }
+            sink = data[0].c0;
+        }
+    });
+    scale_fields<strided>("scale, struct_it strided", data, repetitions);
+    scale_fields<table>("scale, struct_it member pointers", data, repetitions);
+}
@@ -1,7 +1,57 @@
 #ifndef STRUCT_ITER_HPP
 #define STRUCT_ITER_HPP
 
-#include <map>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace detail {
+template<class C>
+constexpr bool construct() {
+    C c{};
+    static_cast<void>(c);
+    return true;
+}
+
+template<class C, class = void>
+constexpr bool is_constexpr_constructible_v = false;
+
+template<class C>
+constexpr bool is_constexpr_constructible_v<C, std::void_t<std::bool_constant<construct<C>()>>> = true;
+
+// Offsets of member pointers are no constant expressions, but the addresses of the members of a
+// constexpr object can be compared.
+template<class C, typename T, T C::*... members>
+constexpr bool members_in_order() {
+    constexpr C obj{};
+    const T *addresses[] = {std::addressof(obj.*members)...};
+    for (std::size_t i = 1; i < sizeof...(members); ++i) {
+        if (!(addresses[i - 1] < addresses[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True iff the members are all members of C in order of declaration. Since there is no padding then,
+// member i is at offset i * sizeof(T) and the members are laid out like an array. The offset of the
+// last member can not be checked directly: offsets of member pointers are no constant expressions and
+// stepping from one member to another is no constant expression either.
+template<class C, typename T, T C::*... members>
+constexpr bool is_contiguous() {
+    using type = std::remove_cv_t<C>;
+    if constexpr (sizeof...(members) > 0 && std::is_standard_layout_v<type> &&
+                  sizeof(type) == sizeof...(members) * sizeof(T) &&
+                  is_constexpr_constructible_v<type>) {
+        return members_in_order<type, T, members...>();
+    } else {
+        return false;
+    }
+}
+}   // namespace detail
+
 template<class C, typename T, T C::*... members>
 class struct_it;
 
@@ -11,10 +61,15 @@ class struct_it {
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using value_type = T;
-    using pointer = T *;
-    using reference = T &;
+    using element_type = std::conditional_t<std::is_const_v<C>, const T, T>;
+    using pointer = element_type *;
+    using reference = element_type &;
     using iterator_category = std::random_access_iterator_tag;
 
+    // Whether the members are accessed with a stride from the first one instead of through the table
+    // of member pointers, so loops over them can be vectorized.
+    constexpr static bool contiguous = detail::is_contiguous<C, T, members...>();
+
     constexpr struct_it(C &c) : _index{0}, _c(std::addressof(c)) {}
 
     constexpr struct_it(size_t index, C &c) : _index{index}, _c(std::addressof(c)) {}
@@ -33,27 +88,27 @@ class struct_it {
     }
 
     constexpr const T &operator*() const {
-        return _c->*_members[_index];
+        return *_address(_index);
     }
 
     constexpr const T *operator->() const {
-        return &(_c->*_members[_index]);
+        return _address(_index);
     }
 
     constexpr const T &operator[](difference_type n) const {
-        return &(_c->*_members[_index + n]);
+        return *_address(_index + n);
     }
 
-    constexpr T &operator*() {
-        return _c->*_members[_index];
+    constexpr reference operator*() {
+        return *_address(_index);
     }
 
-    constexpr T *operator->() {
-        return &(_c->*_members[_index]);
+    constexpr pointer operator->() {
+        return _address(_index);
     }
 
-    constexpr T &operator[](difference_type n) {
-        return &(_c->*_members[_index + n]);
+    constexpr reference operator[](difference_type n) {
+        return *_address(_index + n);
     }
 
     constexpr struct_it &operator--() {
@@ -61,7 +116,7 @@ class struct_it {
         return *this;
     }
 
-    constexpr struct_it &operator--(int) {
+    constexpr struct_it operator--(int) {
         auto copy = *this;
         --_index;
         return copy;
@@ -71,7 +126,7 @@ class struct_it {
         return *this;
     }
 
-    constexpr struct_it &operator++(int) {
+    constexpr struct_it operator++(int) {
         auto copy = *this;
         ++_index;
         return copy;
@@ -106,7 +161,7 @@ class struct_it {
     }
 
     friend bool operator>(const struct_it<C, T, members...> &s, const struct_it<C, T, members...> &t) {
-        return s._index < t._index;
+        return s._index > t._index;
     }
 
     friend bool operator<=(const struct_it<C, T, members...> &s, const struct_it<C, T, members...> &t) {
@@ -123,6 +178,18 @@ class struct_it {
     }
 
   private:
+    constexpr pointer _address(size_type index) const {
+        if constexpr (contiguous) {
+            // Formally undefined behaviour: the standard only allows pointer arithmetic within an
+            // array, not from one member to the next. This relies on the implementation guarantee
+            // that members of the same type without padding between them are laid out like an array,
+            // which GCC, Clang and MSVC give and which is_contiguous checks as far as possible.
+            return std::addressof(_c->*_members[0]) + index;
+        } else {
+            return std::addressof(_c->*_members[index]);
+        }
+    }
+
     size_type _index;
     C *_c;
     constexpr static std::array<T C::*, sizeof...(members)> _members = {members...};
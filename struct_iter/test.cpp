@@ -1,6 +1,8 @@
 #include <iostream>
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <numeric>
 #include "struct_iter.hpp"
 
 struct boundary {
@@ -45,4 +47,20 @@ int main() {
         std::cout << i << ' ';   // Prints 1 2 3 4
     }
     std::cout << '\n';
+
+    // All members in order of declaration, so they are accessed with a stride
+    static_assert(boundary::iter::contiguous);
+    static_assert(offsetof(boundary, right) == 3 * sizeof(int));
+
+    const boundary &cb = b;
+    std::cout << std::accumulate(cb.cbegin(), cb.cend(), 0) << '\n';   // Prints 10
+
+    // Only some of the members, so the table of member pointers is used
+    using sides = struct_it<boundary, int, &boundary::left, &boundary::right>;
+    static_assert(!sides::contiguous);
+
+    for (auto it = sides{b}; it != sides::make_end(b); ++it) {
+        std::cout << *it << ' ';   // Prints 2 1
+    }
+    std::cout << '\n';
 }
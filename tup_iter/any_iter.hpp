@@ -2,6 +2,9 @@
 #define ANY_ITER_HPP
 
 #include "tup_iter.hpp"
+#include <array>
+#include <functional>
+#include <stdexcept>
 #include <type_traits>
 #include <variant>
 
@@ -20,15 +23,18 @@ struct helper_t<Tuple, std::index_sequence<Indices...>> {
 };
 
 template<class Tuple>
-using default_index_sequence = std::make_index_sequence<std::tuple_size_v<std::decay_t<Tuple>>>;
+using default_index_sequence = std::make_index_sequence<size_v<std::decay_t<Tuple>>>;
 
-template<class Begin, class End, size_t... Indices>
-struct span_sequence_impl :
-        span_sequence_impl<decltype(++std::declval<Begin>()), End, Indices..., Begin::index()> {};
+template<size_t First, size_t... Offsets>
+auto offset_sequence(std::index_sequence<Offsets...> /*unused*/)
+    -> std::index_sequence<First + Offsets...>;
 
-template<class Iter, size_t... Indices>
-struct span_sequence_impl<Iter, Iter, Indices...> {
-    using sequence = std::index_sequence<Indices...>;
+// Expands std::make_index_sequence instead of advancing the iterator once per element, so there is
+// no recursive instantiation.
+template<class Begin, class End>
+struct span_sequence_impl {
+    using sequence = decltype(offset_sequence<Begin::index()>(
+        std::make_index_sequence<End::index() - Begin::index()>{}));
 };
 }   // namespace detail
 
@@ -55,6 +61,45 @@ constexpr auto make_any_iter(Tuple &&tup, std::integral_constant<size_t, N> /*un
                              index_seq /*unused*/ = {}) -> AnyIter<Tuple, index_seq> {
     return AnyIter<Tuple, index_seq>{TupleIter<Tuple, N>{std::forward<Tuple>(tup)}};
 }
+
+namespace detail {
+template<class Tuple, class Func>
+using visit_result_t =
+    decltype(std::invoke(std::declval<Func>(), tuple_iter::get<0>(std::declval<Tuple>())));
+
+template<size_t Index, class Tuple, class Func>
+constexpr auto visit_one(Tuple &&tup, Func &&f) -> visit_result_t<Tuple, Func> {
+    return std::invoke(std::forward<Func>(f), tuple_iter::get<Index>(std::forward<Tuple>(tup)));
+}
+
+template<class Tuple, class Func, class Sequence>
+struct jump_table;
+
+template<class Tuple, class Func, size_t... Indices>
+struct jump_table<Tuple, Func, std::index_sequence<Indices...>> {
+    static_assert((std::is_same_v<visit_result_t<Tuple, Func>,
+                                  decltype(visit_one<Indices>(std::declval<Tuple>(),
+                                                              std::declval<Func>()))> &&
+                   ...),
+                  "f has to return the same type for all elements, like for std::visit.");
+
+    using entry_t = visit_result_t<Tuple, Func> (*)(Tuple &&, Func &&);
+    static constexpr std::array<entry_t, sizeof...(Indices)> table{&visit_one<Indices, Tuple, Func>...};
+};
+}   // namespace detail
+
+// Calls f with the element at a runtime index, a single indirect call through a table of functions that
+// is generated at compile time. In contrast to AnyIter, no variant is constructed. As with std::visit,
+// f has to return the same type for each element. Throws std::out_of_range if the index is not
+// smaller than the size of the tuple, like std::array::at.
+template<class Tuple, class Func>
+constexpr auto visit_at(Tuple &&tup, size_t index, Func &&f) -> decltype(auto) {
+    using table_t = detail::jump_table<Tuple, Func, detail::default_index_sequence<Tuple>>;
+    if (index >= table_t::table.size()) {
+        throw std::out_of_range{"visit_at: index out of range"};
+    }
+    return table_t::table[index](std::forward<Tuple>(tup), std::forward<Func>(f));
+}
 }   // namespace tuple_iter
 
 #endif   // ANY_ITER_HPP
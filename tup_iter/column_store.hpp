@@ -0,0 +1,167 @@
+#ifndef COLUMN_STORE_HPP
+#define COLUMN_STORE_HPP
+
+#include "tup_algo.hpp"
+#include "tup_iter.hpp"
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tuple_iter {
+
+// A table with one contiguous std::vector per column. The columns are a tuple, so they can be iterated
+// with TupleIter, e.g. for_each(store.columns_begin(), store.columns_end(), kernel) instantiates the
+// kernel for the type of each column, without any dispatch at runtime.
+template<class... Ts>
+class column_store {
+    static_assert(sizeof...(Ts) > 0, "There has to be at least one column.");
+
+  public:
+    using columns_t = std::tuple<std::vector<Ts>...>;
+    using row_t = std::tuple<Ts...>;
+    using reference = std::tuple<Ts &...>;
+    using const_reference = std::tuple<const Ts &...>;
+    using size_type = size_t;
+
+    template<size_t Index>
+    using column_t = std::tuple_element_t<Index, columns_t>;
+
+  private:
+    using indices = std::index_sequence_for<Ts...>;
+
+  public:
+    // BEGIN Columns
+    template<size_t Index>
+    auto column() noexcept -> column_t<Index> & {
+        return std::get<Index>(m_columns);
+    }
+
+    template<size_t Index>
+    auto column() const noexcept -> const column_t<Index> & {
+        return std::get<Index>(m_columns);
+    }
+
+    // The column an iterator over the columns points to.
+    template<size_t Index>
+    auto column(TupleIter<columns_t, Index> /*unused*/) noexcept -> column_t<Index> & {
+        return std::get<Index>(m_columns);
+    }
+
+    auto columns_begin() noexcept -> begin_t<columns_t> {
+        return begin(m_columns);
+    }
+
+    auto columns_end() noexcept -> end_t<columns_t> {
+        return end(m_columns);
+    }
+
+    auto columns() const noexcept -> const columns_t & {
+        return m_columns;
+    }
+    // END Columns
+
+    // BEGIN Rows
+    auto row(size_type index) -> reference {
+        return std::apply([index](auto &... c) { return reference{c[index]...}; }, m_columns);
+    }
+
+    auto row(size_type index) const -> const_reference {
+        return std::apply([index](auto &... c) { return const_reference{c[index]...}; }, m_columns);
+    }
+
+    // Appends one row. If a column throws, the row is removed from the other columns again.
+    template<class... Args, class = std::enable_if_t<sizeof...(Args) == sizeof...(Ts)>>
+    void push_back(Args &&... values) {
+        const size_type old_size = size();
+        try {
+            push_back_impl(indices{}, std::forward<Args>(values)...);
+        } catch (...) {
+            truncate(old_size);
+            throw;
+        }
+    }
+
+    // Appends a range of rows, which are tuple-like with an element per column. For forward iterators
+    // the columns are reserved once and then filled one after the other, so each is written
+    // sequentially. A single pass range can only be read once, so each row is pushed to all columns
+    // instead. If a column throws, all columns are restored to their previous size.
+    template<class Iter>
+    void append(Iter first, Iter last) {
+        const size_type old_size = size();
+        try {
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                            typename std::iterator_traits<Iter>::iterator_category>) {
+                reserve(old_size + static_cast<size_type>(std::distance(first, last)));
+                append_impl(first, last, indices{});
+            } else {
+                for (; first != last; ++first) {
+                    push_row(*first, indices{});
+                }
+            }
+        } catch (...) {
+            truncate(old_size);
+            throw;
+        }
+    }
+    // END Rows
+
+    // BEGIN Capacity
+    auto size() const noexcept -> size_type {
+        return std::get<0>(m_columns).size();
+    }
+
+    auto empty() const noexcept -> bool {
+        return size() == 0;
+    }
+
+    void reserve(size_type capacity) {
+        std::apply([capacity](auto &... c) { (c.reserve(capacity), ...); }, m_columns);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto &... c) { (c.clear(), ...); }, m_columns);
+    }
+    // END Capacity
+
+  private:
+    template<size_t... Indices, class... Args>
+    void push_back_impl(std::index_sequence<Indices...> /*unused*/, Args &&... values) {
+        (std::get<Indices>(m_columns).push_back(std::forward<Args>(values)), ...);
+    }
+
+    template<class Iter, size_t... Indices>
+    void append_impl(Iter first, Iter last, std::index_sequence<Indices...> /*unused*/) {
+        (append_column<Indices>(first, last), ...);
+    }
+
+    template<class Row, size_t... Indices>
+    void push_row(Row &&row, std::index_sequence<Indices...> /*unused*/) {
+        (std::get<Indices>(m_columns).push_back(std::get<Indices>(std::forward<Row>(row))), ...);
+    }
+
+    template<size_t Index, class Iter>
+    void append_column(Iter first, Iter last) {
+        auto &col = std::get<Index>(m_columns);
+        for (; first != last; ++first) {
+            col.push_back(std::get<Index>(*first));
+        }
+    }
+
+    // Removes the rows from new_size on, in each column that has them.
+    void truncate(size_type new_size) noexcept {
+        auto cut = [new_size](auto &c) {
+            if (c.size() > new_size) {
+                c.erase(c.begin() + static_cast<std::ptrdiff_t>(new_size), c.end());
+            }
+        };
+        std::apply([&cut](auto &... c) { (cut(c), ...); }, m_columns);
+    }
+
+    columns_t m_columns;
+};
+
+}   // namespace tuple_iter
+
+#endif   // COLUMN_STORE_HPP
@@ -0,0 +1,64 @@
+// Measures the compile time of the algorithms on a tuple with TUPLE_SIZE elements of different types.
+// Compile it with compile_bench.sh, the program itself only checks the results.
+#include "tup_algo.hpp"
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifndef TUPLE_SIZE
+#define TUPLE_SIZE 100
+#endif
+
+// Only accesses the elements with std::get, i.e. measures the cost of the tuple itself.
+#ifndef BASELINE
+#define BASELINE 0
+#endif
+
+// find_type_any returns an AnyIter, a std::variant with an alternative per element. Constructing each of
+// them is linear in the number of alternatives with libstdc++, so this part is quadratic and dominates
+// the compile time for large tuples.
+#ifndef WITH_ANY_ITER
+#define WITH_ANY_ITER 1
+#endif
+
+template<size_t... Indices>
+auto make_tuple(std::index_sequence<Indices...> /*unused*/)
+    -> std::tuple<std::integral_constant<size_t, Indices>...>;
+
+using tup_t = decltype(make_tuple(std::make_index_sequence<TUPLE_SIZE>{}));
+
+constexpr size_t expected_sum = TUPLE_SIZE * (TUPLE_SIZE - 1) / 2;
+
+template<class T>
+struct IsLast {
+    constexpr explicit operator bool() const {
+        return T::value == TUPLE_SIZE - 1;
+    }
+};
+
+template<size_t... Indices>
+auto sum_elements(const tup_t &tup, std::index_sequence<Indices...> /*unused*/) -> size_t {
+    return (size_t{0} + ... + std::get<Indices>(tup));
+}
+
+auto main() -> int {
+    using namespace tuple_iter;
+    tup_t tup;
+
+#if BASELINE
+    assert(sum_elements(tup, std::make_index_sequence<TUPLE_SIZE>{}) == expected_sum);
+#else
+    static_assert(find_type_t<IsLast, begin_t<tup_t>, end_t<tup_t>>::index() == TUPLE_SIZE - 1);
+    static_assert(span_sequence<begin_t<tup_t>, end_t<tup_t>>::size() == TUPLE_SIZE);
+
+    size_t sum = 0;
+    tuple_iter::for_each(begin(tup), end(tup), [&sum](auto elem) { sum += elem; });
+    assert(sum == expected_sum && accumulate(begin(tup), end(tup), size_t{0}) == expected_sum);
+
+#if WITH_ANY_ITER
+    auto found = find_type_any(begin(tup), end(tup), [](auto elem) { return elem == 1; });
+    assert(found && found->index() == 1);
+#endif
+#endif
+}
@@ -0,0 +1,43 @@
+#!/bin/sh
+# Compiles compile_bench.cpp for tuples of the given sizes (10, 100 and 500 elements by default) and
+# prints the compile time and, if GNU time is installed, the peak memory of the compiler. The baseline
+# only accesses the elements with std::get, the difference to it is the cost of the algorithms.
+# Usage: ./compile_bench.sh [sizes...], the compiler can be set with CXX.
+#
+# find_type_any is only measured up to ANY_ITER_MAX elements (100 by default). Its AnyIter is a
+# std::variant with an alternative per element, and libstdc++ constructs alternative i through i nested
+# unions, so constructing all of them is quadratic in the size. With GCC 12, 100 elements take about
+# 10 s instead of 1 s without it, and 500 elements did not finish within 8 minutes at 4.5 GB. Set
+# ANY_ITER_MAX to measure larger sizes anyway.
+
+CXX=${CXX:-g++}
+ANY_ITER_MAX=${ANY_ITER_MAX:-100}
+dir=$(dirname "$0")
+out=$(mktemp)
+trap 'rm -f "$out"' EXIT
+
+[ $# -eq 0 ] && set -- 10 100 500
+
+# measure <label> <compiler flags...>
+measure() {
+    label=$1
+    shift
+    if [ -x /usr/bin/time ]; then
+        /usr/bin/time -f "$label: %e s, %M KB" \
+            "$CXX" -std=c++17 -ftemplate-depth=2048 "$@" -o "$out" "$dir/compile_bench.cpp"
+    else
+        start=$(date +%s.%N)
+        "$CXX" -std=c++17 -ftemplate-depth=2048 "$@" -o "$out" "$dir/compile_bench.cpp"
+        echo "$label: $(awk "BEGIN { printf \"%.2f\", $(date +%s.%N) - $start }") s"
+    fi
+}
+
+for size in "$@"; do
+    measure "$size elements, baseline" "-DTUPLE_SIZE=$size" -DBASELINE=1
+    measure "$size elements, algorithms" "-DTUPLE_SIZE=$size" -DWITH_ANY_ITER=0
+    if [ "$size" -le "$ANY_ITER_MAX" ]; then
+        measure "$size elements, with find_type_any" "-DTUPLE_SIZE=$size"
+    else
+        echo "$size elements, with find_type_any: skipped, more than ANY_ITER_MAX=$ANY_ITER_MAX elements"
+    fi
+done
@@ -1,12 +1,60 @@
 #include "any_iter.hpp"
+#include "column_store.hpp"
 #include "tup_algo.hpp"
+#include "tup_hash.hpp"
 #include "tup_iter.hpp"
+#include "type_map.hpp"
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <memory>
 #include <vector>
+#include <string>
+#include <stdexcept>
+#include <future>
+#include <sstream>
+#include <unordered_map>
 
 using namespace tuple_iter;
 
+// Reads the rows of a table from a stream, a single pass iterator like std::istream_iterator.
+class row_reader {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::tuple<int, std::string, double>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    row_reader() = default;
+    explicit row_reader(std::istream &in) : m_in(&in) {
+        ++*this;
+    }
+
+    auto operator*() const -> reference {
+        return m_row;
+    }
+
+    auto operator++() -> row_reader & {
+        if (!(*m_in >> std::get<0>(m_row) >> std::get<1>(m_row) >> std::get<2>(m_row))) {
+            m_in = nullptr;
+        }
+        return *this;
+    }
+
+    friend auto operator==(const row_reader &left, const row_reader &right) -> bool {
+        return left.m_in == right.m_in;
+    }
+
+    friend auto operator!=(const row_reader &left, const row_reader &right) -> bool {
+        return !(left == right);
+    }
+
+  private:
+    std::istream *m_in = nullptr;
+    value_type m_row;
+};
+
 // Templated class that evaluates to true iff it is templated on cv char.
 template<class Found>
 struct StructFinder {
@@ -21,7 +69,7 @@ struct StructFinder {
 // Templated class that searches for the value of its data member.
 template<class Val>
 struct ValueFinder {
-    template<class T, class = std::enable_if_t<!std::is_same_v<Val, T>>>
+    template<class T, class = std::enable_if_t<!std::is_same_v<Val, std::decay_t<T>>>>
     constexpr auto operator()(T && /*unused*/) -> bool {
         return false;
     }
@@ -36,6 +84,52 @@ struct ValueFinder {
 template<class Val>
 ValueFinder(Val)->ValueFinder<Val>;
 
+// Plain records, iterated without converting them to tuples
+struct Point {
+    int x;
+    double y;
+    std::string name;
+};
+
+struct Segment {
+    Point from;
+    Point to;
+};
+
+struct Empty {};
+
+// A reference and a move-only field, each counted as one field
+struct Borrowed {
+    int &count;
+    std::unique_ptr<std::string> label;
+};
+
+// Counts the comparisons, to check that tuple_equal compares the packed fields first. Not an aggregate,
+// so it is compared as a whole.
+class Compared {
+  public:
+    static inline int comparisons = 0;
+
+    friend auto operator==(const Compared &lhs, const Compared &rhs) -> bool {
+        ++comparisons;
+        return lhs.m_value == rhs.m_value;
+    }
+
+  private:
+    double m_value = 0;
+};
+
+// Generic replacement for a hand-written hash per struct, recurses into nested structs.
+template<class T>
+auto hash_fields(const T &value) -> size_t {
+    if constexpr (std::is_aggregate_v<T>) {
+        auto combine = [](size_t seed, const auto &field) { return seed * 31 + hash_fields(field); };
+        return accumulate(begin(value), end(value), size_t{17}, combine);
+    } else {
+        return std::hash<T>{}(value);
+    }
+}
+
 auto main() -> int {
     std::tuple<int, const char, double> tup{1, 'A', 2.1};
     using tup_t = decltype(tup);
@@ -94,4 +188,165 @@ auto main() -> int {
 
     assert(sum1(0.) == sum2);
     std::cout << '\n' << sum2 << '\n';
+
+    // Heterogeneous counters
+    auto positive = [](auto v) { return v > 0; };
+    assert(any_of(begin(numbers), end(numbers), positive));
+    assert(!all_of(begin(numbers), end(numbers), positive));
+    // Empty ranges have to be qualified, otherwise std::all_of is the better match for equal types
+    assert(tuple_iter::all_of(begin(numbers), begin(numbers), positive));
+    assert(!tuple_iter::any_of(end(numbers), end(numbers), positive));
+    assert(count_if(begin(numbers), end(numbers), positive) == 4);
+    assert(min_element(begin(numbers), end(numbers))->index() == 3);
+    assert(max_element(begin(numbers), end(numbers))->index() == 4);
+
+    auto squares = transform_reduce(begin(numbers), --end(numbers), 0., std::plus<>{},
+                                    [](auto v) { return v * v; });
+    assert(squares > 62 && squares < 63);
+    assert(std::abs(reduce(++begin(numbers), --end(numbers)) - sum2) < 1e-9);
+
+    // The accumulator is moved through, the order of a tree reduction differs from accumulate
+    std::tuple<std::string, const char *, char, std::string> words{"a", "b", 'c', "d"};
+    assert(accumulate(++begin(words), end(words), std::string{"a"}) == "abcd");
+    assert(reduce(begin(words), end(words), std::string{}) == "abcd");
+
+    // Heterogeneous shards processed concurrently
+    std::tuple<std::vector<int>, std::string, std::vector<double>> shards{
+        {1, 2, 3}, "shard", {0.5, 1.5}};
+
+    parallel_for_each(begin(shards), end(shards), [](auto &shard) {
+        for (auto &elem: shard) {
+            elem += 1;
+        }
+    });
+    assert(std::get<0>(shards)[2] == 4 && std::get<1>(shards) == "tibse" &&
+           std::get<2>(shards)[0] == 1.5);
+
+    auto sizes = parallel_transform(begin(shards), end(shards),
+                                    [](const auto &shard) { return shard.size(); });
+    static_assert(std::tuple_size_v<decltype(sizes)> == 3);
+    assert(std::get<0>(sizes) == 3 && std::get<1>(sizes) == 5 && std::get<2>(sizes) == 2);
+
+    auto firsts = transform(++begin(shards), end(shards), [](auto &shard) { return shard[0]; });
+    static_assert(std::is_same_v<decltype(firsts), std::tuple<char, double>>);
+
+    // Any callable returning a future can be the executor, this one runs the tasks lazily on get()
+    auto deferred = [](auto task) { return std::async(std::launch::deferred, task); };
+    try {
+        parallel_for_each(begin(shards), end(shards), [](const auto &shard) {
+            if (shard.size() == 5) {
+                throw std::runtime_error{"Broken shard"};
+            }
+        }, deferred);
+        assert(false);
+    } catch (const std::runtime_error &) {
+    }
+
+    // Runtime index without constructing a variant
+    std::tuple<int, std::string, double> message{7, "text", 0.25};
+    auto describe = [](const auto &elem) {
+        std::ostringstream out;
+        out << elem;
+        return out.str();
+    };
+    assert(visit_at(message, 1, describe) == "text" && visit_at(message, 2, describe) == "0.25");
+    for (size_t index: {0, 1}) {
+        visit_at(message, index, [](auto &elem) { elem = std::remove_reference_t<decltype(elem)>{}; });
+    }
+    assert(std::get<0>(message) == 0 && std::get<1>(message).empty());
+    try {
+        visit_at(message, 3, describe);
+        assert(false);
+    } catch (const std::out_of_range &) {
+    }
+
+    // Columnar table
+    column_store<int, std::string, double> table;
+    table.push_back(1, "one", 1.5);
+    std::vector<std::tuple<int, std::string, double>> rows{{2, "two", 2.5}, {3, "three", 3.5}};
+    table.append(rows.begin(), rows.end());
+    assert(table.size() == 3 && std::get<1>(table.row(2)) == "three");
+    std::istringstream more_rows{"4 four 4.5 5 five 5.5"};
+    table.append(row_reader{more_rows}, row_reader{});
+    assert(table.size() == 5 && std::get<1>(table.row(4)) == "five" && table.column<2>()[3] == 4.5);
+
+    std::get<0>(table.row(0)) = 10;
+    assert(table.column<0>()[0] == 10);
+
+    // One kernel per column, each instantiated for the type of its column
+    size_t cells = 0;
+    tuple_iter::for_each(table.columns_begin(), table.columns_end(),
+                         [&cells](const auto &column) { cells += column.size(); });
+    assert(cells == 15);
+
+    // Scanning a single column
+    double total = 0;
+    for (double d: table.column(++++table.columns_begin())) {
+        total += d;
+    }
+    assert(total == 17.5);
+
+    // Type to index map and dispatch by type tag
+    using handlers_t = std::tuple<int, std::string, double, char>;
+    static_assert(index_of_v<double, handlers_t> == 2);
+    static_assert(type_map<handlers_t>::contains<char> && !type_map<handlers_t>::contains<float>);
+    static_assert(type_map<handlers_t>::find(type_tag_v<std::string>) == 1);
+    static_assert(type_map<handlers_t>::find(type_tag_v<float>) == type_map<handlers_t>::size);
+
+    handlers_t handlers{1, "two", 3.0, '4'};
+    std::vector<std::uint64_t> queue{type_tag_v<char>, type_tag_v<int>, type_tag_v<std::string>};
+    std::string routed;
+    for (auto tag: queue) {
+        routed += dispatch(handlers, tag, describe);
+    }
+    assert(routed == "41two");
+    try {
+        dispatch(handlers, type_tag_v<float>, describe);
+        assert(false);
+    } catch (const std::invalid_argument &) {
+    }
+
+    // Aggregates
+    static_assert(size_v<Point> == 3 && size_v<Segment> == 2 && size_v<Empty> == 0);
+    static_assert(std::is_same_v<element_t<1, const Point>, const double>);
+    static_assert(size_v<Borrowed> == 2 && std::is_same_v<element_t<0, Borrowed>, int>);
+    int borrowed_count = 1;
+    Borrowed borrowed{borrowed_count, std::make_unique<std::string>("label")};
+    ++tuple_iter::get<0>(borrowed);
+    assert(borrowed_count == 2 && *tuple_iter::get<1>(borrowed) == "label");
+    Point point{1, 2.5, "p"};
+    std::ostringstream serialized;
+    tuple_iter::for_each(begin(point), end(point),
+                         [&serialized](const auto &field) { serialized << field << ';'; });
+    assert(serialized.str() == "1;2.5;p;");
+
+    *++begin(point) = 3.5;
+    tuple_iter::get<2>(point) += "q";
+    assert(point.y == 3.5 && point.name == "pq");
+    assert((index_of_v<std::string, Point> == 2) && visit_at(point, 0, describe) == "1");
+
+    Segment segment{{1, 2.5, "a"}, {3, 4.5, "b"}};
+    const Segment same = segment;
+    assert(hash_fields(segment) == hash_fields(same));
+    segment.to.name = "c";
+    assert(hash_fields(segment) != hash_fields(same));
+    assert(tuple_iter::all_of(begin(same), end(same), [](const Point &p) { return p.x > 0; }));
+
+    // Field-wise hash and equality for join keys, tuples and structs
+    using join_key_t = std::tuple<int, int, short, char, long>;
+    std::unordered_map<join_key_t, int, tuple_hash<join_key_t>, tuple_equal<join_key_t>> joined;
+    for (int i = 0; i < 100; ++i) {
+        joined[{i, i / 2, static_cast<short>(i % 3), 'k', -i}] = i;
+    }
+    assert(joined.size() == 100 && joined.at({41, 20, 2, 'k', -41}) == 41);
+    assert(joined.count({41, 20, 2, 'j', -41}) == 0);
+
+    std::unordered_map<Segment, int, tuple_hash<Segment>, tuple_equal<Segment>> segments{{same, 1}};
+    assert(segments.count(same) == 1 && segments.count(segment) == 0);
+    assert(tuple_equal<Point>{}({0, 0.0, ""}, {0, -0.0, ""}));
+    assert(tuple_hash<Point>{}({0, 0.0, ""}) == tuple_hash<Point>{}({0, -0.0, ""}));
+
+    using tagged_t = std::tuple<Compared, int>;
+    assert(!tuple_equal<tagged_t>{}({Compared{}, 1}, {Compared{}, 2}) && Compared::comparisons == 0);
+    assert(tuple_equal<tagged_t>{}({Compared{}, 1}, {Compared{}, 1}) && Compared::comparisons == 1);
 }
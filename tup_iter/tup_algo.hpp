@@ -2,25 +2,149 @@
 #define TUP_ALGO_HPP
 
 #include "any_iter.hpp"
+#include <functional>
+#include <future>
 #include <optional>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace tuple_iter {
 
+namespace detail {
+// Position of the first element whose type fulfills Pred, the size of the sequence if there is none.
+template<template<class> class Pred, class Tuple, size_t... Indices>
+constexpr auto find_first(std::index_sequence<Indices...> /*unused*/) noexcept -> size_t {
+    constexpr bool found[] = {
+        static_cast<bool>(Pred<element_t<Indices, std::decay_t<Tuple>>>())..., false};
+    size_t pos = 0;
+    while (pos < sizeof...(Indices) && !found[pos]) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Position of Index in the sequence, the alternative of AnyIter for the iterator with this index.
+template<size_t Index, size_t... Indices>
+constexpr auto position_in(std::index_sequence<Indices...> /*unused*/) noexcept -> size_t {
+    constexpr size_t indices[] = {Indices..., Index};
+    size_t pos = 0;
+    while (indices[pos] != Index) {
+        ++pos;
+    }
+    return pos;
+}
+
+// The || stops at the first element for which pred is true. The alternative is selected by its
+// position, since the converting constructor of a large variant is expensive to compile.
+template<class Sequence, class Tuple, class Pred, class Result, size_t... Indices>
+constexpr void find_any_impl(Tuple &tup, Pred &pred, Result &ret,
+                             std::index_sequence<Indices...> /*unused*/) {
+    auto found = [&ret, &tup](auto position) {
+        ret.emplace(std::in_place_index<decltype(position)::value>, tup);
+        return true;
+    };
+    static_cast<void>(
+        ((pred(tuple_iter::get<Indices>(tup)) &&
+          found(std::integral_constant<size_t, position_in<Indices>(Sequence{})>{})) ||
+         ...));
+}
+
+template<class Tuple, class Func, size_t... Indices>
+constexpr void for_each_impl(Tuple &tup, Func &f, std::index_sequence<Indices...> /*unused*/) {
+    (static_cast<void>(f(tuple_iter::get<Indices>(tup))), ...);
+}
+
+// Carries the accumulated value through the fold expression, its type may change with every element.
+// The value is moved into each call of op, so accumulating into e.g. a string does not copy it.
+template<class Op, class Val>
+struct fold_state {
+    Op &op;
+    Val value;
+};
+
+template<class Op, class Val, class Elem>
+constexpr auto operator%(fold_state<Op, Val> &&state, Elem &elem)
+    -> fold_state<Op, decltype(state.op(std::move(state.value), elem))> {
+    return {state.op, state.op(std::move(state.value), elem)};
+}
+
+template<class Tuple, class Val, class Op, size_t... Indices>
+constexpr auto accumulate_impl(Tuple &tup, Val &v, Op &op, std::index_sequence<Indices...> /*unused*/) {
+    return (fold_state<Op, Val>{op, std::move(v)} % ... % tuple_iter::get<Indices>(tup)).value;
+}
+
+template<class Tuple, class Pred, size_t... Indices>
+constexpr auto any_of_impl(Tuple &tup, Pred &pred, std::index_sequence<Indices...> /*unused*/) -> bool {
+    return (static_cast<bool>(pred(tuple_iter::get<Indices>(tup))) || ...);
+}
+
+template<class Tuple, class Pred, size_t... Indices>
+constexpr auto all_of_impl(Tuple &tup, Pred &pred, std::index_sequence<Indices...> /*unused*/) -> bool {
+    return (static_cast<bool>(pred(tuple_iter::get<Indices>(tup))) && ...);
+}
+
+template<class Tuple, class Pred, size_t... Indices>
+constexpr auto count_if_impl(Tuple &tup, Pred &pred, std::index_sequence<Indices...> /*unused*/)
+    -> size_t {
+    return (size_t{0} + ... +
+            static_cast<size_t>(static_cast<bool>(pred(tuple_iter::get<Indices>(tup)))));
+}
+
+// Pairwise reduction of the Count elements starting at First, the depth of the tree is logarithmic in
+// Count, so independent combinations can execute in parallel and rounding errors grow slower.
+template<size_t First, size_t Count, class Tuple, class Op>
+constexpr auto tree_reduce(Tuple &tup, Op &op) {
+    if constexpr (Count == 1) {
+        return tuple_iter::get<First>(tup);
+    } else {
+        return op(tree_reduce<First, Count / 2>(tup, op),
+                  tree_reduce<First + Count / 2, Count - Count / 2>(tup, op));
+    }
+}
+
+// Keeps the best value seen so far as the common type of the range, the element only needs to be
+// compared once. Ties keep the first element, like std::min_element.
+template<class Sequence, class Tuple, class Comp, class Result, size_t... Indices>
+constexpr void best_element_impl(Tuple &tup, Comp &comp, Result &ret,
+                                 std::index_sequence<Indices...> /*unused*/) {
+    using value_t = std::common_type_t<element_t<Indices, std::decay_t<Tuple>>...>;
+    std::optional<value_t> best;
+    auto visit = [&](const auto &elem, auto position) {
+        if (!best || comp(elem, *best)) {
+            best.emplace(elem);
+            ret.emplace(std::in_place_index<decltype(position)::value>, tup);
+        }
+    };
+    (visit(tuple_iter::get<Indices>(tup),
+           std::integral_constant<size_t, position_in<Indices>(Sequence{})>{}),
+     ...);
+}
+
+template<class Tuple, class Func, size_t... Indices>
+constexpr auto transform_impl(Tuple &tup, Func &f, std::index_sequence<Indices...> /*unused*/) {
+    return std::tuple<decltype(f(tuple_iter::get<Indices>(tup)))...>{
+        f(tuple_iter::get<Indices>(tup))...};
+}
+
+// One task per element, each with its own copy of f.
+template<class Tuple, class Func, class Executor, size_t... Indices>
+auto dispatch(Tuple &tup, const Func &f, Executor &executor,
+              std::index_sequence<Indices...> /*unused*/) {
+    return std::tuple{executor([&tup, f]() mutable { return f(tuple_iter::get<Indices>(tup)); })...};
+}
+}   // namespace detail
+
+// The algorithms expand the index sequence of the range in fold expressions instead of recursing
+// once per element, so large tuples do not need deep template instantiations.
+
 // Type based find algorithm, only works on the types. Pred should be a class template that explicitly
 // converts to bool.
 template<template<class> class Pred, class Begin, class End>
-constexpr auto find_type(Begin begin, End end) noexcept {
-    if constexpr (begin == end) {
-        return end;
-    } else {
-        if constexpr (Pred<typename Begin::value_t>()) {
-            return begin;
-        } else {
-            return find_type<Pred>(++begin, end);
-        }
-    }
+constexpr auto find_type(Begin begin, [[maybe_unused]] End end) noexcept {
+    constexpr auto offset =
+        detail::find_first<Pred, typename Begin::tuple_t>(span_sequence<Begin, End>{});
+    return begin.template advance<offset>();
 }
 
 template<template<class> class Pred, class Begin, class End>
@@ -29,41 +153,137 @@ using find_type_t = decltype(find_type<Pred>(std::declval<Begin>(), std::declval
 // Value based find algorithm, can use both types and values in the tuple. Pred should be an object that
 // can be called with each of the searched types.
 template<class Pred, class Begin, class End, class Sequence = span_sequence<Begin, End>>
-constexpr auto find_type_any(Begin begin, End end, Pred pred, Sequence seq = {}) noexcept
+constexpr auto find_type_any(Begin begin, [[maybe_unused]] End end, Pred pred,
+                             Sequence /*unused*/ = {}) noexcept
     -> std::optional<AnyIter<typename Begin::tuple_t, Sequence>> {
-    if constexpr (begin == end) {
-        return {};
-    } else {
-        if (pred(*begin)) {
-            return {begin};
-        } else {
-            return find_type_any(++begin, end, pred, seq);
-        }
-    }
+    std::optional<AnyIter<typename Begin::tuple_t, Sequence>> ret;
+    detail::find_any_impl<Sequence>(begin.get_tuple(), pred, ret, span_sequence<Begin, End>{});
+    return ret;
 }
 
 // Applies f on each element in the iterated range. f should be an object that is callable on each of
 // the types in the range.
 template<class Begin, class End, class Func>
-constexpr auto for_each(Begin begin, End end, Func f) noexcept -> Func {
-    if constexpr (begin == end) {
-        return f;
-    } else {
-        f(*begin);
-        return for_each(++begin, end, f);
-    }
+constexpr auto for_each(Begin begin, [[maybe_unused]] End end, Func f) noexcept -> Func {
+    detail::for_each_impl(begin.get_tuple(), f, span_sequence<Begin, End>{});
+    return f;
 }
 
 // Accumulates the iterated range in the form:
 //   Op(...Op(Op(v, begin), ++begin), ..., end)
 // Op should be an object that can be called appropriately.
 template<class Begin, class End, class Val = typename Begin::value_t, class Op = std::plus<>>
-constexpr auto accumulate(Begin begin, End end, Val v = {}, Op op = {}) noexcept {
-    if constexpr (begin == end) {
+constexpr auto accumulate(Begin begin, [[maybe_unused]] End end, Val v = {}, Op op = {}) noexcept {
+    return detail::accumulate_impl(begin.get_tuple(), v, op, span_sequence<Begin, End>{});
+}
+
+// Like accumulate, but applies f on each element before combining it, i.e.
+//   Op(...Op(Op(v, f(*begin)), f(*++begin)), ...)
+template<class Begin, class End, class Val, class Op, class Func>
+constexpr auto transform_reduce(Begin begin, [[maybe_unused]] End end, Val v, Op op, Func f) {
+    auto combine = [&op, &f](auto &&acc, auto &elem) {
+        return op(std::forward<decltype(acc)>(acc), f(elem));
+    };
+    return detail::accumulate_impl(begin.get_tuple(), v, combine, span_sequence<Begin, End>{});
+}
+
+// Combines the iterated range pairwise like a balanced tree, e.g. for four elements
+//   Op(v, Op(Op(*begin, *++begin), Op(*++++begin, *++++++begin)))
+// Op has to be associative, v is returned for an empty range.
+template<class Begin, class End, class Val = typename Begin::value_t, class Op = std::plus<>>
+constexpr auto reduce(Begin begin, [[maybe_unused]] End end, Val v = {}, Op op = {}) {
+    constexpr size_t count = distance_v<Begin, End>;
+    if constexpr (count == 0) {
         return v;
     } else {
-        return accumulate(++begin, end, op(v, *begin), op);
+        return op(std::move(v), detail::tree_reduce<Begin::index(), count>(begin.get_tuple(), op));
+    }
+}
+
+// True iff pred is true for any element, stops at the first one.
+template<class Begin, class End, class Pred>
+constexpr auto any_of(Begin begin, [[maybe_unused]] End end, Pred pred) -> bool {
+    return detail::any_of_impl(begin.get_tuple(), pred, span_sequence<Begin, End>{});
+}
+
+// True iff pred is true for all elements, stops at the first one for which it is false.
+template<class Begin, class End, class Pred>
+constexpr auto all_of(Begin begin, [[maybe_unused]] End end, Pred pred) -> bool {
+    return detail::all_of_impl(begin.get_tuple(), pred, span_sequence<Begin, End>{});
+}
+
+template<class Begin, class End, class Pred>
+constexpr auto none_of(Begin begin, End end, Pred pred) -> bool {
+    return !any_of(begin, end, pred);
+}
+
+// Number of elements for which pred is true.
+template<class Begin, class End, class Pred>
+constexpr auto count_if(Begin begin, [[maybe_unused]] End end, Pred pred) -> size_t {
+    return detail::count_if_impl(begin.get_tuple(), pred, span_sequence<Begin, End>{});
+}
+
+// The first smallest element with respect to comp, the range must not be empty. The elements are
+// compared as their common type.
+template<class Begin, class End, class Comp = std::less<>, class Sequence = span_sequence<Begin, End>>
+constexpr auto min_element(Begin begin, [[maybe_unused]] End end, Comp comp = {},
+                           Sequence /*unused*/ = {})
+    -> std::optional<AnyIter<typename Begin::tuple_t, Sequence>> {
+    static_assert(distance_v<Begin, End> > 0, "There is no element in an empty range.");
+    std::optional<AnyIter<typename Begin::tuple_t, Sequence>> ret;
+    detail::best_element_impl<Sequence>(begin.get_tuple(), comp, ret, span_sequence<Begin, End>{});
+    return ret;
+}
+
+// The first largest element with respect to comp, the range must not be empty.
+template<class Begin, class End, class Comp = std::less<>, class Sequence = span_sequence<Begin, End>>
+constexpr auto max_element(Begin begin, [[maybe_unused]] End end, Comp comp = {},
+                           Sequence /*unused*/ = {})
+    -> std::optional<AnyIter<typename Begin::tuple_t, Sequence>> {
+    auto greater = [&comp](const auto &lhs, const auto &rhs) { return comp(rhs, lhs); };
+    static_assert(distance_v<Begin, End> > 0, "There is no element in an empty range.");
+    std::optional<AnyIter<typename Begin::tuple_t, Sequence>> ret;
+    detail::best_element_impl<Sequence>(begin.get_tuple(), greater, ret, span_sequence<Begin, End>{});
+    return ret;
+}
+
+// Applies f on each element in the iterated range and returns the results as a tuple, i.e.
+//   std::tuple{f(*begin), f(*++begin), ...}
+// f has to return a value for each of the types.
+template<class Begin, class End, class Func>
+constexpr auto transform(Begin begin, [[maybe_unused]] End end, Func f) {
+    return detail::transform_impl(begin.get_tuple(), f, span_sequence<Begin, End>{});
+}
+
+// Default executor of the parallel algorithms, starts a thread for each task with std::async. An
+// executor is called with a task without arguments and has to return a future-like object of its
+// result, so a thread pool can be used as well.
+struct async_executor {
+    template<class Task>
+    auto operator()(Task &&task) const {
+        return std::async(std::launch::async, std::forward<Task>(task));
     }
+};
+
+// Like for_each, but f is applied to the elements concurrently, each application is one task of the
+// executor with its own copy of f. Returns after all tasks finished, the first exception (in the order
+// of the range) is rethrown then.
+template<class Begin, class End, class Func, class Executor = async_executor>
+void parallel_for_each(Begin begin, [[maybe_unused]] End end, Func f, Executor executor = {}) {
+    auto &tup = begin.get_tuple();
+    auto futures = detail::dispatch(tup, f, executor, span_sequence<Begin, End>{});
+    std::apply([](auto &... fut) { (fut.wait(), ...); }, futures);
+    std::apply([](auto &... fut) { (fut.get(), ...); }, futures);
+}
+
+// Like transform, but f is applied to the elements concurrently as in parallel_for_each.
+template<class Begin, class End, class Func, class Executor = async_executor>
+auto parallel_transform(Begin begin, [[maybe_unused]] End end, Func f, Executor executor = {}) {
+    auto &tup = begin.get_tuple();
+    auto futures = detail::dispatch(tup, f, executor, span_sequence<Begin, End>{});
+    std::apply([](auto &... fut) { (fut.wait(), ...); }, futures);
+    return std::apply(
+        [](auto &... fut) { return std::tuple<decltype(fut.get())...>{fut.get()...}; }, futures);
 }
 
 }   // namespace tuple_iter
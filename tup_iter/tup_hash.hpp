@@ -0,0 +1,169 @@
+#ifndef TUP_HASH_HPP
+#define TUP_HASH_HPP
+
+#include "tup_iter.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace tuple_iter {
+
+namespace detail {
+// Values that are equal iff their bytes are equal, e.g. integers, enums and pointers, but no floating
+// point types. Up to a word of them are hashed and compared as raw bytes.
+template<class T>
+constexpr bool packable_v = std::is_trivially_copyable_v<T> &&
+                            std::has_unique_object_representations_v<T> && sizeof(T) <= 8;
+
+template<class T>
+auto to_word(const T &value) noexcept -> std::uint64_t {
+    std::uint64_t word = 0;
+    std::memcpy(&word, &value, sizeof(T));
+    return word;
+}
+
+// Packs adjacent packable fields into words and mixes each word into the hash once, instead of hashing
+// and combining every field on its own. The offsets in the word are known at compile time after
+// inlining, so the packing is only shifts and ors.
+struct word_hasher {
+    template<class T>
+    void add(const T &value) noexcept {
+        if (used + sizeof(T) > 8) {
+            flush();
+        }
+        word |= to_word(value) << (8 * used);
+        used += sizeof(T);
+    }
+
+    void add_hash(std::uint64_t value) noexcept {
+        hash = mix(hash ^ value);
+    }
+
+    auto finish() noexcept -> size_t {
+        flush();
+        return static_cast<size_t>(hash ^ (hash >> 29));
+    }
+
+  private:
+    static constexpr auto mix(std::uint64_t value) noexcept -> std::uint64_t {
+        value *= 0x9e3779b97f4a7c15ULL;
+        return value ^ (value >> 32);
+    }
+
+    void flush() noexcept {
+        if (used != 0) {
+            add_hash(word);
+            word = 0;
+            used = 0;
+        }
+    }
+
+    std::uint64_t hash = 0x84222325cbf29ce4ULL;
+    std::uint64_t word = 0;
+    size_t used = 0;
+};
+
+// Compares packable fields by xor without branching.
+struct word_comparer {
+    template<class T>
+    void add(const T &lhs, const T &rhs) noexcept {
+        diff |= to_word(lhs) ^ to_word(rhs);
+    }
+
+    auto finish() const noexcept -> bool {
+        return diff == 0;
+    }
+
+  private:
+    std::uint64_t diff = 0;
+};
+
+template<class T>
+void hash_value(word_hasher &hasher, const T &value);
+
+template<class T, size_t... Indices>
+void hash_fields(word_hasher &hasher, const T &value, std::index_sequence<Indices...> /*unused*/) {
+    (hash_value(hasher, tuple_iter::get<Indices>(value)), ...);
+}
+
+// Nested tuples and structs are hashed field by field as well, everything else with std::hash.
+template<class T>
+void hash_value(word_hasher &hasher, const T &value) {
+    if constexpr (packable_v<T>) {
+        hasher.add(value);
+    } else if constexpr (is_decomposable_v<T>) {
+        hash_fields(hasher, value, std::make_index_sequence<size_v<T>>{});
+    } else {
+        hasher.add_hash(std::hash<T>{}(value));
+    }
+}
+
+template<class T>
+void compare_words(word_comparer &comparer, const T &lhs, const T &rhs);
+
+template<class T, size_t... Indices>
+void compare_word_fields(word_comparer &comparer, const T &lhs, const T &rhs,
+                         std::index_sequence<Indices...> /*unused*/) {
+    (compare_words(comparer, tuple_iter::get<Indices>(lhs), tuple_iter::get<Indices>(rhs)), ...);
+}
+
+// First pass of the equality, only the packable fields.
+template<class T>
+void compare_words(word_comparer &comparer, const T &lhs, const T &rhs) {
+    if constexpr (packable_v<T>) {
+        comparer.add(lhs, rhs);
+    } else if constexpr (is_decomposable_v<T>) {
+        compare_word_fields(comparer, lhs, rhs, std::make_index_sequence<size_v<T>>{});
+    }
+}
+
+template<class T>
+auto equal_rest(const T &lhs, const T &rhs) -> bool;
+
+template<class T, size_t... Indices>
+auto equal_rest_fields(const T &lhs, const T &rhs, std::index_sequence<Indices...> /*unused*/)
+    -> bool {
+    return (equal_rest(tuple_iter::get<Indices>(lhs), tuple_iter::get<Indices>(rhs)) && ...);
+}
+
+// Second pass, the fields that are not packable with operator==, stopping at the first difference.
+template<class T>
+auto equal_rest(const T &lhs, const T &rhs) -> bool {
+    if constexpr (packable_v<T>) {
+        return true;
+    } else if constexpr (is_decomposable_v<T>) {
+        return equal_rest_fields(lhs, rhs, std::make_index_sequence<size_v<T>>{});
+    } else {
+        return lhs == rhs;
+    }
+}
+}   // namespace detail
+
+// Hash of a tuple or aggregate, e.g. for keys of std::unordered_map. Adjacent integral fields are
+// packed into words, see word_hasher.
+template<class Tuple>
+struct tuple_hash {
+    auto operator()(const Tuple &tup) const -> size_t {
+        detail::word_hasher hasher;
+        detail::hash_value(hasher, tup);
+        return hasher.finish();
+    }
+};
+
+// Field-wise equality consistent with tuple_hash. The integral fields are compared first without
+// branches, and only if they are all equal are the other fields compared with operator==, so unequal
+// keys rarely get to compare strings.
+template<class Tuple>
+struct tuple_equal {
+    auto operator()(const Tuple &lhs, const Tuple &rhs) const -> bool {
+        detail::word_comparer comparer;
+        detail::compare_words(comparer, lhs, rhs);
+        return comparer.finish() && detail::equal_rest(lhs, rhs);
+    }
+};
+
+}   // namespace tuple_iter
+
+#endif   // TUP_HASH_HPP
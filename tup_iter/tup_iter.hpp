@@ -4,6 +4,7 @@
 #include <iterator>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace tuple_iter {
@@ -12,6 +13,177 @@ namespace tuple_iter {
 template<size_t Index>
 inline constexpr std::integral_constant<size_t, Index> index_tag;
 
+// BEGIN - Aggregate Section
+// Aggregates without a tuple interface are decomposed with structured bindings, so plain structs can be
+// iterated without tying them into a tuple first. Everything in this library accesses elements through
+// get, size_v and element_t below, which forward to the std versions for tuple-like types.
+
+namespace detail {
+template<class T, class = void>
+constexpr bool is_tuple_like_v = false;
+
+template<class T>
+constexpr bool is_tuple_like_v<T, std::void_t<decltype(std::tuple_size<T>::value)>> = true;
+
+template<class T>
+constexpr bool is_decomposable_v =
+    is_tuple_like_v<std::remove_cv_t<T>> || std::is_aggregate_v<std::remove_cv_t<T>>;
+
+// Converts to the type of any field, only used in unevaluated context to count the initializers of an
+// aggregate. Since it converts to nested aggregates as well, their braces are not elided and each
+// initializer is exactly one field. The conversion to an lvalue initializes reference members; the
+// ref-qualifiers make the conversion to a value the better match for all other fields, which may not be
+// copyable.
+struct any_field {
+    template<class T>
+    constexpr operator T() const && noexcept;
+
+    template<class T>
+    constexpr operator T &() const & noexcept;
+};
+
+template<size_t>
+using any_field_t = any_field;
+
+template<class T, class Sequence, class = void>
+constexpr bool accepts_v = false;
+
+template<class T, size_t... Indices>
+constexpr bool
+    accepts_v<T, std::index_sequence<Indices...>, std::void_t<decltype(T{any_field_t<Indices>{}...})>> =
+        true;
+
+inline constexpr size_t max_fields = 16;
+
+// The largest number of initializers T accepts, one more than max_fields are probed to detect too large
+// structs.
+template<class T, size_t... Counts>
+constexpr auto count_fields(std::index_sequence<Counts...> /*unused*/) noexcept -> size_t {
+    size_t count = 0;
+    ((count = accepts_v<T, std::make_index_sequence<Counts>> ? Counts : count), ...);
+    return count;
+}
+
+template<class T>
+inline constexpr size_t field_count_v = count_fields<T>(std::make_index_sequence<max_fields + 2>{});
+
+// A tuple of references to the fields of agg. Copying references is free after inlining, so this does
+// not cost more than accessing the fields by name.
+template<class Agg>
+constexpr auto tie_fields(Agg &agg) noexcept {
+    constexpr size_t count = field_count_v<std::remove_cv_t<Agg>>;
+    static_assert(count <= max_fields, "Structs with more than max_fields fields are not supported.");
+    static_assert(count != 0 || std::is_empty_v<Agg>,
+                  "No initializer of the struct could be counted, e.g. because of an rvalue reference.");
+
+    if constexpr (count == 0) {
+        return std::tuple<>{};
+    } else if constexpr (count == 1) {
+        auto &[f0] = agg;
+        return std::tie(f0);
+    } else if constexpr (count == 2) {
+        auto &[f0, f1] = agg;
+        return std::tie(f0, f1);
+    } else if constexpr (count == 3) {
+        auto &[f0, f1, f2] = agg;
+        return std::tie(f0, f1, f2);
+    } else if constexpr (count == 4) {
+        auto &[f0, f1, f2, f3] = agg;
+        return std::tie(f0, f1, f2, f3);
+    } else if constexpr (count == 5) {
+        auto &[f0, f1, f2, f3, f4] = agg;
+        return std::tie(f0, f1, f2, f3, f4);
+    } else if constexpr (count == 6) {
+        auto &[f0, f1, f2, f3, f4, f5] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5);
+    } else if constexpr (count == 7) {
+        auto &[f0, f1, f2, f3, f4, f5, f6] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6);
+    } else if constexpr (count == 8) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+    } else if constexpr (count == 9) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+    } else if constexpr (count == 10) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+    } else if constexpr (count == 11) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+    } else if constexpr (count == 12) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+    } else if constexpr (count == 13) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+    } else if constexpr (count == 14) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+    } else if constexpr (count == 15) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+    } else if constexpr (count == 16) {
+        auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = agg;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+    }
+}
+}   // namespace detail
+
+// Element Index of a tuple-like object or field Index of an aggregate.
+template<size_t Index, class T,
+         class = std::enable_if_t<detail::is_decomposable_v<std::remove_reference_t<T>>>>
+constexpr auto get(T &&t) noexcept -> decltype(auto) {
+    if constexpr (detail::is_tuple_like_v<std::decay_t<T>>) {
+        return std::get<Index>(std::forward<T>(t));
+    } else {
+        auto &field = std::get<Index>(detail::tie_fields(t));
+        if constexpr (std::is_lvalue_reference_v<T>) {
+            return field;
+        } else {
+            return std::move(field);
+        }
+    }
+}
+
+namespace detail {
+template<class T, class = void>
+struct size_impl {};
+
+template<class T>
+struct size_impl<T, std::enable_if_t<is_tuple_like_v<T>>> : std::tuple_size<T> {};
+
+// Goes through tie_fields, so a count that does not match the structured binding fails to compile
+// here already, e.g. for C array members, whose braces are elided, or for base classes.
+template<class T>
+struct size_impl<T, std::enable_if_t<!is_tuple_like_v<T> && std::is_aggregate_v<T>>> :
+        std::tuple_size<decltype(tie_fields(std::declval<T &>()))> {};
+
+template<size_t Index, class T, class = void>
+struct element_impl {};
+
+template<size_t Index, class T>
+struct element_impl<Index, T, std::enable_if_t<is_tuple_like_v<std::remove_cv_t<T>>>> :
+        std::tuple_element<Index, T> {};
+
+template<size_t Index, class T>
+struct element_impl<Index, T,
+                    std::enable_if_t<!is_tuple_like_v<std::remove_cv_t<T>> &&
+                                     std::is_aggregate_v<std::remove_cv_t<T>>>> {
+    using type = std::remove_reference_t<decltype(tuple_iter::get<Index>(std::declval<T &>()))>;
+};
+}   // namespace detail
+
+// Like std::tuple_size_v, the number of fields for aggregates.
+template<class T>
+inline constexpr size_t size_v = detail::size_impl<std::remove_cv_t<T>>::value;
+
+// Like std::tuple_element_t, the type of the field for aggregates.
+template<size_t Index, class T>
+using element_t = typename detail::element_impl<Index, T>::type;
+
+// END - Aggregate Section
+
 template<class Tup, size_t Index>
 struct TupleIter {
     using tuple_t = Tup;
@@ -23,7 +195,7 @@ struct TupleIter {
     // BEGIN - Static Method Section
 
     static constexpr auto size() noexcept -> size_t {
-        return std::tuple_size_v<std::decay_t<tuple_t>>;
+        return size_v<std::decay_t<tuple_t>>;
     }
 
     static constexpr auto index() noexcept -> size_t {
@@ -33,7 +205,7 @@ struct TupleIter {
     template<class Inp>
     static constexpr decltype(auto) get(Inp &&inp) {
         if constexpr (Index < size()) {
-            return std::get<Index>(inp);
+            return tuple_iter::get<Index>(std::forward<Inp>(inp));
         } else {
             // Improves error messages.
             static_assert(Index < size(), "Enditerator is not dereferencable.");
@@ -47,7 +219,7 @@ struct TupleIter {
     tuple_t &tup;
 
     // Helper for value_t since we cannot specialize a type alias directly and have to prevent the
-    // instantiation of std::tuple_element_t<I, tuple_t> for the case of I == size() sinze then this
+    // instantiation of element_t<I, tuple_t> for the case of I == size() sinze then this
     // would not compile. Hence, we cannot simply use std::conditional.
 
     // value_t for the past-the-end iterator
@@ -62,7 +234,7 @@ struct TupleIter {
     // value_t for all dereferencable iterators
     template<size_t I>
     struct helper_struct<I, std::enable_if_t<(I < size())>> {
-        using value_type = std::tuple_element_t<I, std::decay_t<tuple_t>>;
+        using value_type = element_t<I, std::decay_t<tuple_t>>;
         using next_type = TupleIter<tuple_t, Index + 1>;
     };
 
@@ -120,17 +292,17 @@ struct TupleIter {
 
     template<size_t I = Index, class = std::enable_if_t<(I < size())>>
     constexpr auto operator*() noexcept -> value_t & {
-        return std::get<Index>(tup);
+        return tuple_iter::get<Index>(tup);
     }
 
     template<size_t I = Index, class = std::enable_if_t<(I < size())>>
     constexpr auto operator*() const noexcept -> const value_t & {
-        return std::get<Index>(tup);
+        return tuple_iter::get<Index>(tup);
     }
 
     template<size_t I = Index, class = std::enable_if_t<(I < size())>>
     constexpr explicit operator value_t() const {
-        return std::get<index()>(tup);
+        return tuple_iter::get<index()>(tup);
     }
 
     [[nodiscard]] constexpr auto get_tuple() const noexcept -> const tuple_t & {
@@ -187,7 +359,7 @@ template<class T>
 using begin_t = TupleIter<T, 0>;
 
 template<class T>
-using end_t = TupleIter<T, std::tuple_size_v<std::decay_t<T>>>;
+using end_t = TupleIter<T, size_v<std::decay_t<T>>>;
 
 template<class T>
 constexpr auto begin([[maybe_unused]] T &tup) noexcept -> begin_t<T> {
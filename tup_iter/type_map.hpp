@@ -0,0 +1,248 @@
+#ifndef TYPE_MAP_HPP
+#define TYPE_MAP_HPP
+
+#include "any_iter.hpp"
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tuple_iter {
+
+namespace detail {
+// FNV-1a of the signature of this function, which contains the name of T.
+template<class T>
+constexpr auto type_hash() noexcept -> std::uint64_t {
+#if defined(_MSC_VER)
+    constexpr std::string_view name = __FUNCSIG__;
+#else
+    constexpr std::string_view name = __PRETTY_FUNCTION__;
+#endif
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (char c: name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Finalizer of splitmix64, seed selects one of a family of hash functions.
+constexpr auto mix(std::uint64_t tag, std::uint64_t seed) noexcept -> std::uint64_t {
+    tag ^= seed * 0x9e3779b97f4a7c15ULL;
+    tag = (tag ^ (tag >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    tag = (tag ^ (tag >> 27)) * 0x94d049bb133111ebULL;
+    return tag ^ (tag >> 31);
+}
+
+constexpr auto bit_ceil(size_t n) noexcept -> size_t {
+    size_t ret = 1;
+    while (ret < n) {
+        ret *= 2;
+    }
+    return ret;
+}
+
+template<size_t N>
+constexpr auto all_unique(const std::array<std::uint64_t, N> &tags) noexcept -> bool {
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t j = i + 1; j < N; ++j) {
+            if (tags[i] == tags[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Perfect hash of N distinct keys by hash and displace: the keys are distributed into N buckets with
+// one hash function, then for each bucket (largest first) a displacement is searched, which selects a
+// second hash function that puts all keys of the bucket into free slots. A lookup is two hashes and
+// two loads.
+template<size_t N>
+struct perfect_hash {
+    static constexpr size_t slots = bit_ceil(2 * N);
+
+    constexpr explicit perfect_hash(const std::array<std::uint64_t, N> &keys) {
+        for (auto &index: indices) {
+            index = N;
+        }
+
+        // Counting sort of the keys by bucket, bucket b holds order[first[b]] to order[first[b + 1]].
+        std::array<size_t, N + 1> first{};
+        for (auto key: keys) {
+            ++first[bucket(key) + 1];
+        }
+        size_t largest = 0;
+        for (size_t b = 0; b < N; ++b) {
+            largest = largest < first[b + 1] ? first[b + 1] : largest;
+            first[b + 1] += first[b];
+        }
+        std::array<size_t, N> order{};
+        std::array<size_t, N> filled{};
+        for (size_t i = 0; i < N; ++i) {
+            const size_t b = bucket(keys[i]);
+            order[first[b] + filled[b]++] = i;
+        }
+
+        for (size_t count = largest; count > 0; --count) {
+            for (size_t b = 0; b < N; ++b) {
+                if (first[b + 1] - first[b] == count) {
+                    place(keys, b, order.data() + first[b], count);
+                }
+            }
+        }
+    }
+
+    // The position of the key, N if it is none of the keys.
+    constexpr auto find(std::uint64_t key) const noexcept -> size_t {
+        const size_t s = slot(key, displacement[bucket(key)]);
+        return indices[s] != N && tags[s] == key ? indices[s] : N;
+    }
+
+  private:
+    static constexpr auto bucket(std::uint64_t key) noexcept -> size_t {
+        return static_cast<size_t>(mix(key, 0) % N);
+    }
+
+    static constexpr auto slot(std::uint64_t key, std::uint64_t disp) noexcept -> size_t {
+        return static_cast<size_t>(mix(key, disp + 1) & (slots - 1));
+    }
+
+    // Searches the first displacement that puts the count keys of bucket b into distinct free slots.
+    constexpr void place(const std::array<std::uint64_t, N> &keys, size_t b, const size_t *members,
+                         size_t count) {
+        for (std::uint64_t disp = 0;; ++disp) {
+            size_t placed = 0;
+            for (; placed < count; ++placed) {
+                const size_t s = slot(keys[members[placed]], disp);
+                if (indices[s] != N) {
+                    break;
+                }
+                indices[s] = members[placed];
+                tags[s] = keys[members[placed]];
+            }
+            if (placed == count) {
+                displacement[b] = disp;
+                return;
+            }
+            while (placed > 0) {
+                indices[slot(keys[members[--placed]], disp)] = N;
+            }
+        }
+    }
+
+    std::array<std::uint64_t, N> displacement{};
+    std::array<std::uint64_t, slots> tags{};
+    std::array<size_t, slots> indices{};
+};
+
+template<class T, size_t Index>
+struct type_leaf {};
+
+// Derives from one leaf per element, so the index of a type is found by overload resolution on the
+// bases instead of a search.
+template<class Tuple, class Sequence>
+struct type_leaves;
+
+template<class Tuple, size_t... Indices>
+struct type_leaves<Tuple, std::index_sequence<Indices...>> :
+        type_leaf<element_t<Indices, Tuple>, Indices>... {};
+
+// Expands the pack directly, tuple_element_t would walk the tuple once per element.
+template<class... Ts, size_t... Indices>
+struct type_leaves<std::tuple<Ts...>, std::index_sequence<Indices...>> : type_leaf<Ts, Indices>... {};
+
+template<class T, size_t Index>
+constexpr auto leaf_index(const type_leaf<T, Index> * /*unused*/) noexcept -> size_t {
+    return Index;
+}
+
+template<class T, class Leaves, class = void>
+constexpr bool has_leaf_v = false;
+
+template<class T, class Leaves>
+constexpr bool has_leaf_v<T, Leaves,
+                          std::void_t<decltype(leaf_index<T>(std::declval<const Leaves *>()))>> = true;
+
+template<class Tuple, size_t... Indices>
+constexpr auto make_tags(const Tuple * /*unused*/, std::index_sequence<Indices...> /*unused*/) noexcept
+    -> std::array<std::uint64_t, sizeof...(Indices)> {
+    return {type_hash<element_t<Indices, Tuple>>()...};
+}
+
+template<class... Ts, size_t... Indices>
+constexpr auto make_tags(const std::tuple<Ts...> * /*unused*/,
+                         std::index_sequence<Indices...> /*unused*/) noexcept
+    -> std::array<std::uint64_t, sizeof...(Ts)> {
+    return {type_hash<Ts>()...};
+}
+}   // namespace detail
+
+// Compile-time constant that identifies the type T at runtime, e.g. as the key of messages. It hashes
+// the spelling of the type in __PRETTY_FUNCTION__ (__FUNCSIG__ on MSVC), which differs between
+// compilers and may change with their versions, so tags are only valid within one build and must not
+// be stored or sent to another program.
+template<class T>
+inline constexpr std::uint64_t type_tag_v = detail::type_hash<T>();
+
+// Maps the types of a tuple to their indices. It is built once per tuple type, then index_of<T> is a
+// single lookup and find(tag) a perfect hash for runtime tags. Each type may occur only once.
+template<class Tuple>
+struct type_map {
+    using tuple_t = std::decay_t<Tuple>;
+
+    static constexpr size_t size = size_v<tuple_t>;
+    static constexpr std::array<std::uint64_t, size> tags =
+        detail::make_tags(static_cast<const tuple_t *>(nullptr), std::make_index_sequence<size>{});
+
+    static_assert(detail::all_unique(tags), "A type occurs more than once in the tuple.");
+
+  private:
+    using leaves = detail::type_leaves<tuple_t, std::make_index_sequence<size>>;
+
+    template<class T>
+    static constexpr auto index_of_impl() noexcept -> size_t {
+        static_assert(detail::has_leaf_v<T, leaves>, "The type has to occur once in the tuple.");
+        return detail::leaf_index<T>(static_cast<const leaves *>(nullptr));
+    }
+
+  public:
+    template<class T>
+    static constexpr bool contains = detail::has_leaf_v<T, leaves>;
+
+    template<class T>
+    static constexpr size_t index_of = index_of_impl<T>();
+
+    // The index of the element whose type has the tag, size if there is none.
+    static constexpr auto find(std::uint64_t tag) noexcept -> size_t {
+        if constexpr (size == 0) {
+            return 0;
+        } else {
+            return hash.find(tag);
+        }
+    }
+
+  private:
+    static constexpr detail::perfect_hash<size> hash{tags};
+};
+
+template<class T, class Tuple>
+inline constexpr size_t index_of_v = type_map<Tuple>::template index_of<T>;
+
+// Calls f with the element whose type has the tag. This is a perfect hash lookup and an indirect call,
+// see visit_at. Throws std::invalid_argument if the tag is not the one of a type of the tuple.
+template<class Tuple, class Func>
+constexpr auto dispatch(Tuple &&tup, std::uint64_t tag, Func &&f) -> decltype(auto) {
+    const size_t index = type_map<Tuple>::find(tag);
+    if (index == type_map<Tuple>::size) {
+        throw std::invalid_argument{"dispatch: unknown type tag"};
+    }
+    return visit_at(std::forward<Tuple>(tup), index, std::forward<Func>(f));
+}
+
+}   // namespace tuple_iter
+
+#endif   // TYPE_MAP_HPP
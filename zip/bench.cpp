@@ -0,0 +1,200 @@
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "zip.hpp"
+
+// Read after each repetition, so the compiler cannot merge the repetitions into one pass.
+volatile float sink;
+
+template<class Func>
+void measure(const char *name, Func f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << elapsed.count() << " ms\n";
+}
+
+int main() {
+    constexpr std::size_t size = 10'000'003;   // Not a multiple of the width, so the tail is used
+    constexpr int repetitions = 50;
+    constexpr std::size_t width = zip_iter::default_width<float>;
+
+    const std::vector<float> x(size, 0.5f);
+    std::vector<float> y(size, 1.f);
+
+    measure("dot product, indexed loop", [&] {
+        float dot = 0.f;
+        for (int r = 0; r < repetitions; ++r) {
+            float acc[width] = {};
+            std::size_t i = 0;
+            for (; i + width <= size; i += width) {
+                for (std::size_t j = 0; j < width; ++j) {
+                    acc[j] += x[i + j] * y[i + j];
+                }
+            }
+            for (; i < size; ++i) {
+                acc[0] += x[i] * y[i];
+            }
+            for (float a: acc) {
+                dot += a;
+            }
+        }
+        std::cout << dot << '\n';
+    });
+
+    measure("dot product, zip", [&] {
+        float dot = 0.f;
+        for (int r = 0; r < repetitions; ++r) {
+            for (auto [a, b]: zip_iter::zip_same_length(x, y)) {
+                dot += a * b;
+            }
+        }
+        std::cout << dot << '\n';
+    });
+
+    measure("dot product, batches", [&] {
+        float dot = 0.f;
+        for (int r = 0; r < repetitions; ++r) {
+            zip_iter::pack<float, width> acc;
+            float rest = 0.f;
+            zip_iter::for_each_batch<width>(
+                zip_iter::zip_same_length(x, y),
+                [&acc](const auto &a, const auto &b) { acc += a * b; },
+                [&rest](float a, float b) { rest += a * b; });
+            dot += sum(acc) + rest;
+        }
+        std::cout << dot << '\n';
+    });
+
+    measure("axpy, indexed loop", [&] {
+        for (int r = 0; r < repetitions; ++r) {
+            for (std::size_t i = 0; i < size; ++i) {
+                y[i] = 0.5f * x[i] + y[i];
+            }
+            sink = y[static_cast<std::size_t>(r)];
+        }
+        std::cout << y.back() << '\n';
+    });
+
+    measure("axpy, batches", [&] {
+        for (int r = 0; r < repetitions; ++r) {
+            zip_iter::for_each_batch<width, 1>(zip_iter::zip_same_length(x, y),
+                                               [](const auto &a, auto &b) { b = 0.5f * a + b; });
+            sink = y[static_cast<std::size_t>(r)];
+        }
+        std::cout << y.back() << '\n';
+    });
+
+    constexpr std::size_t rows = 5'000'000;
+    std::vector<std::uint32_t> keys(rows);
+    std::vector<double> first(rows, 1.);
+    std::vector<double> second(rows, 2.);
+    std::vector<double> third(rows, 3.);
+    std::vector<double> fourth(rows, 4.);
+    std::uint32_t state = 1;
+    for (auto &key: keys) {
+        state = state * 1664525u + 1013904223u;   // Linear congruential generator
+        key = state;
+    }
+
+    measure("sort index array and gather", [&] {
+        auto k = keys;
+        auto f = first;
+        auto s = second;
+        std::vector<std::size_t> index(rows);
+        std::iota(index.begin(), index.end(), std::size_t{0});
+        std::sort(index.begin(), index.end(), [&k](auto l, auto r) { return k[l] < k[r]; });
+        std::vector<std::uint32_t> sorted_k(rows);
+        std::vector<double> sorted_f(rows);
+        std::vector<double> sorted_s(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            sorted_k[i] = k[index[i]];
+            sorted_f[i] = f[index[i]];
+            sorted_s[i] = s[index[i]];
+        }
+        std::cout << sorted_k[0] << '\n';
+    });
+
+    std::vector<std::size_t> perm(rows);
+    std::iota(perm.begin(), perm.end(), std::size_t{0});
+    std::sort(perm.begin(), perm.end(), [&keys](auto l, auto r) { return keys[l] < keys[r]; });
+
+    measure("gather two columns", [&] {
+        auto f = first;
+        auto s = second;
+        zip_iter::gather(perm, f);
+        zip_iter::gather(perm, s);
+        std::cout << f[0] + s[0] << '\n';
+    });
+
+    measure("bucketed permutation of two columns", [&] {
+        auto f = first;
+        auto s = second;
+        zip_iter::permute_columns<std::uint32_t>(perm, f, s);
+        std::cout << f[0] + s[0] << '\n';
+    });
+
+    measure("gather four columns", [&] {
+        auto f = first;
+        auto s = second;
+        auto t = third;
+        auto u = fourth;
+        for (auto *column: {&f, &s, &t, &u}) {
+            zip_iter::gather(perm, *column);
+        }
+        std::cout << f[0] + s[0] + t[0] + u[0] << '\n';
+    });
+
+    measure("bucketed permutation of four columns", [&] {
+        auto f = first;
+        auto s = second;
+        auto t = third;
+        auto u = fourth;
+        zip_iter::permute_columns<std::uint32_t>(perm, f, s, t, u);
+        std::cout << f[0] + s[0] + t[0] + u[0] << '\n';
+    });
+
+    measure("apply_permutation in place", [&] {
+        auto f = first;
+        auto s = second;
+        zip_iter::apply_permutation(perm, f, s);
+        std::cout << f[0] + s[0] << '\n';
+    });
+
+    measure("sort_by_key", [&] {
+        auto k = keys;
+        auto f = first;
+        auto s = second;
+        zip_iter::sort_by_key(k, f, s);
+        std::cout << k[0] << '\n';
+    });
+
+    measure("sort_by_key, three value columns", [&] {
+        auto k = keys;
+        auto f = first;
+        auto s = second;
+        auto t = third;
+        zip_iter::sort_by_key(k, f, s, t);
+        std::cout << k[0] << '\n';
+    });
+
+    measure("radix_sort_by_key", [&] {
+        auto k = keys;
+        auto f = first;
+        auto s = second;
+        zip_iter::radix_sort_by_key(k, f, s);
+        std::cout << k[0] << '\n';
+    });
+
+    measure("radix_sort_by_key, three value columns", [&] {
+        auto k = keys;
+        auto f = first;
+        auto s = second;
+        auto t = third;
+        zip_iter::radix_sort_by_key(k, f, s, t);
+        std::cout << k[0] << '\n';
+    });
+}
@@ -4,6 +4,13 @@
 #include <map>
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <memory>
+#include <array>
+#include <cstdint>
+#include <iterator>
 
 using namespace zip_iter;
 
@@ -30,4 +37,246 @@ int main() {
     for (auto [i, v]: with_index(strings)) {
         std::cout << i << ": " << v << '\n';
     }
+
+    std::cout << "Sorting by key\n";
+    std::vector<int> keys{3, 1, 4, 1, 5, 9, 2, 6};
+    std::vector<std::string> values{"three", "one", "four", "one", "five", "nine", "two", "six"};
+    zip by_key(keys, values);
+    static_assert(std::is_same_v<decltype(by_key.begin())::iterator_category,
+                                 std::random_access_iterator_tag>);
+    assert(by_key.end() - by_key.begin() == 8);
+
+    std::sort(by_key.begin(), by_key.end());
+    assert(std::is_sorted(begin(keys), end(keys)) && values.back() == "nine");
+
+    auto found = std::lower_bound(by_key.begin(), by_key.end(), 4, [](const auto &elem, int key) {
+        return std::get<0>(elem) < key;
+    });
+    assert(std::get<1>(*found) == "four" && std::get<0>(found[1]) == 5);
+
+    for (auto [k, v]: by_key) {
+        std::cout << k << ": " << v << '\n';
+    }
+
+    // The shorter range limits the distance, sets only allow bidirectional iteration
+    std::vector<int> longer{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    assert(zip(keys, longer).end() - zip(keys, longer).begin() == 8);
+    static_assert(std::is_same_v<decltype(zip(nums, strings).begin())::iterator_category,
+                                 std::bidirectional_iterator_tag>);
+
+    std::cout << "Same length\n";
+    std::vector<double> xs{1., 2., 3.};
+    std::vector<double> ys{4., 5., 6.};
+    zip_same_length same(xs, ys);
+    assert(same.size() == 3 && same.end() - same.begin() == 3);
+
+    double dot = 0.;
+    same.for_each([&dot](double x, double y) { dot += x * y; });
+    assert(dot == 32.);
+
+    for (auto [x, y]: same) {
+        std::cout << x << " * " << y << '\n';
+    }
+
+    try {
+        zip_same_length mismatch(xs, longer);
+        assert(false);
+    } catch (const std::invalid_argument &) {
+    }
+
+    std::cout << "Parallel\n";
+    std::vector<long> column(1000);
+    std::vector<long> squares(1000);
+    auto parts = chunks(with_index(column), 3);
+    assert(parts.size() == 3 && std::get<0>(*parts[1].begin()) == 384);
+
+    parallel_for_each(with_index(column), [](auto elem) { std::get<1>(elem) = std::get<0>(elem); }, 4);
+    parallel_for_each(zip_same_length(column, squares), [](auto elem) {
+        auto [c, s] = elem;
+        s = c * c;
+    });
+    assert(column[999] == 999 && squares[999] == 999 * 999 && squares[383] == 383 * 383);
+
+    std::cout << "Batches\n";
+    std::vector<float> x(19, 2.f);
+    std::vector<float> y(19, 1.f);
+    pack<float, 8> acc;
+    float rest = 0.f;
+    for_each_batch<8>(zip_same_length(std::as_const(x), y), [&acc](const auto &a, const auto &b) {
+        acc += a * b;
+    }, [&rest](float a, float b) { rest += a * b; });
+    assert(sum(acc) + rest == 38.f);
+
+    // axpy, only y is written back, x is only read
+    for_each_batch<4, 1>(zip(x, y), [](auto &a, auto &b) {
+        b = 3.f * a + b;
+        a = 0.f;
+    });
+    assert(y[0] == 7.f && y[18] == 7.f);
+    assert(std::all_of(x.begin(), x.end(), [](float a) { return a == 2.f; }));
+
+    std::cout << "Temporaries\n";
+    auto compute = [] { return std::vector<int>{1, 2, 3}; };
+    std::vector<int> out(3);
+    auto owning = zip(compute(), out);
+    static_assert(std::is_same_v<decltype(owning),
+                                 zip<owned_range<std::vector<int>>, std::vector<int>::iterator>>);
+    for (auto [in, o]: owning) {
+        o = 2 * in;
+    }
+    assert(out[2] == 6);
+
+    auto copied = owning;   // Copies the temporary
+    std::get<0>(*owning.begin()) = 5;
+    auto moved_zip = std::move(copied);
+    assert(std::get<0>(*moved_zip.begin()) == 1 && std::get<0>(*owning.begin()) == 5);
+
+    for (auto [i, s]: with_index(std::vector<std::string>{"zero", "one"})) {
+        std::cout << i << ": " << s << '\n';
+    }
+
+    const auto owned_column = with_index(std::vector<long>(200, 7));
+    auto owned_parts = chunks(owned_column, 2);
+    assert(owned_parts.size() == 2 && std::get<1>(*owned_parts[1].begin()) == 7);
+
+    // Zips of lvalues only hold iterators, so they work in constant expressions
+    static_assert([] {
+        std::array<int, 3> left{1, 2, 3};
+        const std::array<int, 3> right{4, 5, 6};
+        int dot = 0;
+        for (auto [l, r]: zip(left, right)) {
+            dot += l * r;
+        }
+        for (auto [i, l]: with_index(left)) {
+            l = static_cast<int>(i);
+        }
+        return dot + left[2];
+    }() == 34);
+
+    std::cout << "Unzip\n";
+    std::vector<int> firsts;
+    std::vector<std::string> seconds(3);
+    std::transform(begin(nums), begin(nums) + 3, unzip(std::back_inserter(firsts), begin(seconds)),
+                   [](int n) { return std::pair{n + 1, std::to_string(n)}; });
+    assert(firsts.size() == 3 && firsts[2] == 4 && seconds[2] == "3");
+
+    // Splitting a zipped range, also works with move-only types
+    std::vector<std::unique_ptr<int>> owners;
+    std::vector<std::unique_ptr<int>> moved;
+    std::vector<int> plain;
+    owners.push_back(std::make_unique<int>(42));
+    std::transform(begin(owners), end(owners),
+                   unzip(std::back_inserter(moved), std::back_inserter(plain)), [](auto &p) {
+                       int value = *p;
+                       return std::tuple{std::move(p), value};
+                   });
+    assert(*moved[0] == 42 && plain[0] == 42 && !owners[0]);
+
+    std::cout << "Bounded iota\n";
+    iota evens(0, 9, 2);
+    assert(evens.size() == 5 && *(evens.begin() + 4) == 8 && evens.end() - evens.begin() == 5);
+    for (auto [i, e]: zip(iota<int>(0, 3), evens)) {
+        std::cout << i << ": " << e << '\n';
+    }
+#if defined(__cpp_lib_concepts)
+    static_assert(std::random_access_iterator<iota<int>::iota_iter>);
+#endif
+
+    // The value after the last one does not fit into the type, the position does
+    iota<std::uint8_t> bytes(0, 255, 2);
+    assert(bytes.size() == 128 && bytes.end()[-1] == 254 && 1 + bytes.begin() < bytes.end());
+    assert(std::count_if(bytes.begin(), bytes.end(), [](auto b) { return b % 2 == 0; }) == 128);
+    assert((iota<signed char>(-128, 127, 5).size() == 51));
+    try {
+        iota<int> backwards(0, 3, -1);
+        assert(false);
+    } catch (const std::invalid_argument &) {
+    }
+
+    auto indexed = with_index(nums);
+    assert(indexed.end() - indexed.begin() == 4 && *std::get<0>(indexed.end().base()) == 4);
+
+    std::cout << "Sorting parallel arrays\n";
+    std::vector<int> ids{5, -3, 9, 0, -3, 7};
+    std::vector<std::string> names{"e", "a", "i", "z", "b", "g"};
+    std::vector<std::unique_ptr<int>> payload;
+    for (int id: ids) {
+        payload.push_back(std::make_unique<int>(id));
+    }
+
+    sort_by_key(ids, names, payload);
+    assert(std::is_sorted(begin(ids), end(ids)) && names[5] == "i" && *payload[5] == 9);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        assert(*payload[i] == ids[i]);
+    }
+
+    std::vector<int> radix_ids{5, -3, 9, 0, -3, 7, 1 << 20, -(1 << 20)};
+    std::vector<std::string> radix_names{"e", "a", "i", "z", "b", "g", "big", "small"};
+    auto stable_ids = radix_ids;
+    auto stable_names = radix_names;
+    radix_sort_by_key(radix_ids, radix_names);
+    stable_sort_by_key(stable_ids, stable_names);
+    assert(radix_ids == stable_ids && radix_names == stable_names);
+    assert(radix_names[0] == "small" && radix_names[1] == "a" && radix_names[2] == "b");
+
+    // Enough rows and columns for the buckets, the column whose moves may throw is gathered
+    struct throwing_move {
+        int value;
+        throwing_move(int v) : value(v) {}
+        throwing_move(throwing_move &&other) noexcept(false) : value(other.value) {}
+        auto operator=(throwing_move &&other) noexcept(false) -> throwing_move & {
+            value = other.value;
+            return *this;
+        }
+    };
+    std::vector<int> many_keys;
+    std::vector<std::size_t> many_positions;
+    std::vector<std::string> many_names;
+    std::vector<double> many_halves;
+    std::vector<throwing_move> many_values;
+    std::uint32_t state = 1;
+    for (std::size_t pos = 0; pos < 100'000; ++pos) {
+        state = state * 1664525u + 1013904223u;
+        many_keys.push_back(static_cast<int>(state >> 8));
+        many_positions.push_back(pos);
+        many_names.push_back(std::to_string(many_keys.back()));
+        many_halves.push_back(many_keys.back() / 2.);
+        many_values.emplace_back(many_keys.back());
+    }
+    const auto unsorted_keys = many_keys;
+    radix_sort_by_key(many_keys, many_positions, many_names, many_halves, many_values);
+    assert(std::is_sorted(begin(many_keys), end(many_keys)));
+    for (std::size_t i = 0; i < many_keys.size(); ++i) {
+        assert(unsorted_keys[many_positions[i]] == many_keys[i]);
+        assert(many_names[i] == std::to_string(many_keys[i]) && many_halves[i] == many_keys[i] / 2.);
+        assert(many_values[i].value == many_keys[i]);
+    }
+
+    std::vector<char> letters{'a', 'b', 'c', 'd', 'e', 'f'};
+    std::vector<std::unique_ptr<int>> numbers;
+    for (int n = 0; n < 6; ++n) {
+        numbers.push_back(std::make_unique<int>(n));
+    }
+    // Two cycles, 0 <- 3 <- 2 <- 1 <- 0 and 4 <-> 5
+    apply_permutation(std::vector<std::size_t>{3, 0, 1, 2, 5, 4}, letters, numbers);
+    assert((letters == std::vector<char>{'d', 'a', 'b', 'c', 'f', 'e'}));
+    assert(*numbers[0] == 3 && *numbers[3] == 2 && *numbers[4] == 5);
+    try {
+        apply_permutation(std::vector<std::size_t>{1, 1, 0, 3, 4, 5}, letters, numbers);
+        assert(false);
+    } catch (const std::invalid_argument &) {
+        assert(std::all_of(begin(numbers), end(numbers), [](const auto &p) { return p != nullptr; }));
+    }
+    for (auto sort: {sort_by_key<std::vector<int>, std::vector<std::string>>,
+                     stable_sort_by_key<std::vector<int>, std::vector<std::string>>,
+                     radix_sort_by_key<std::vector<int>, std::vector<std::string>>}) {
+        std::vector<int> short_keys{3, 2, 1};
+        std::vector<std::string> short_names{"c", "b"};
+        try {
+            sort(short_keys, short_names);
+            assert(false);
+        } catch (const std::invalid_argument &) {
+            assert((short_keys == std::vector<int>{3, 2, 1}));
+        }
+    }
 }
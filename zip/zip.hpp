@@ -4,7 +4,19 @@
 #include <tuple>
 #include <type_traits>
 #include <limits>
-#include <cstddef>   // std::size_t
+#include <cstddef>    // std::size_t, std::ptrdiff_t
+#include <cstdint>    // std::uint32_t
+#include <iterator>   // std::iterator_traits, std::begin, std::end
+#include <utility>    // std::swap
+#include <stdexcept>  // std::invalid_argument
+#include <algorithm>  // std::for_each, std::max
+#include <exception>  // std::exception_ptr
+#include <thread>     // std::thread
+#include <vector>     // std::vector
+#include <array>      // std::array
+#include <cassert>    // assert
+#include <memory>     // std::unique_ptr
+#include <new>        // placement new, std::launder
 
 namespace zip_iter {
 namespace {
@@ -20,122 +32,1183 @@ constexpr auto comp(const std::tuple<Iters...> &left, const std::tuple<Iters...>
     }
 }
 
+// Since we stop at the shortest range, the distance is the one with the smallest absolute value.
+template<class Diff, class... Iters, std::size_t... I>
+constexpr auto shortest_distance(const std::tuple<Iters...> &left, const std::tuple<Iters...> &right,
+                                 std::index_sequence<I...> /*unused*/) -> Diff {
+    const Diff diffs[] = {static_cast<Diff>(std::get<I>(left) - std::get<I>(right))...};
+    Diff ret = diffs[0];
+    for (Diff d: diffs) {
+        if ((d < 0 ? -d : d) < (ret < 0 ? -ret : ret)) {
+            ret = d;
+        }
+    }
+    return ret;
+}
+
 // Poor man's concept...
 template<class Container>
 using is_container_t =
     std::void_t<decltype((std::begin(std::declval<Container>()), std::end(std::declval<Container>())))>;
+
+template<class Category, class... Iters>
+constexpr bool all_categories_v =
+    (std::is_base_of_v<Category, typename std::iterator_traits<Iters>::iterator_category> && ...);
+
+// A single argument of type Self is a copy, not a range to zip.
+template<class Self, class... Ranges>
+constexpr bool is_self_v =
+    sizeof...(Ranges) == 1 &&
+    (std::is_same_v<std::remove_cv_t<std::remove_reference_t<Ranges>>, Self> && ...);
 }   // namespace
 
-template<class... Iters>
-struct zip {
-    constexpr zip(std::pair<Iters, Iters>... iters) : m_begin{iters.first...}, m_end{iters.second...} {}
+// The result of dereferencing a zip_iterator. It is a tuple of the references of the zipped iterators,
+// which assigns through to the referenced objects and can be swapped as an rvalue, so that it works with
+// algorithms like std::sort.
+template<class... Refs>
+struct zip_reference : std::tuple<Refs...> {
+    using base = std::tuple<Refs...>;
+    using base::base;
+    using base::operator=;
 
-    template<class... containers, class = std::void_t<is_container_t<containers>...>>
-    constexpr zip(containers &... cs) : zip(std::make_pair(std::begin(cs), std::end(cs))...) {}
+    constexpr zip_reference(const zip_reference &) = default;
+    constexpr zip_reference(zip_reference &&) = default;
 
-    struct zip_iterator {
-        constexpr zip_iterator(Iters... its) : m_iters(its...) {}
+    // Assigns the referenced values, like the base class does.
+    constexpr auto operator=(const zip_reference &other) -> zip_reference & {
+        base::operator=(static_cast<const base &>(other));
+        return *this;
+    }
 
-        constexpr auto operator++() -> zip_iterator & {
-            std::apply([](auto &... it) { std::make_tuple(++it...); }, m_iters);
-            return *this;
-        }
+    constexpr auto operator=(zip_reference &&other) -> zip_reference & {
+        base::operator=(static_cast<base &&>(other));
+        return *this;
+    }
 
-        constexpr auto operator++(int) -> zip_iterator & {
-            return std::apply([](auto &... it) { std::make_tuple(it++...); }, m_iters);
-        }
+    friend constexpr void swap(zip_reference left, zip_reference right) {
+        swap_impl(left, right, std::index_sequence_for<Refs...>{});
+    }
 
-        constexpr auto operator*() -> std::tuple<decltype(*std::declval<Iters>()) &...> {
-            return std::apply([](auto &... it) { return std::tie(*it...); }, m_iters);
-        }
+  private:
+    template<std::size_t... I>
+    static constexpr void swap_impl(zip_reference &left, zip_reference &right,
+                                    std::index_sequence<I...> /*unused*/) {
+        using std::swap;
+        (swap(std::get<I>(left), std::get<I>(right)), ...);
+    }
+};
+
+// The iterator of zip. The category is the weakest of the zipped iterators, but at most random access.
+// The operations of bidirectional and random access iterators are only available if all iterators
+// support them. If SameLength is set, all ranges are known to have the same length, so only the first
+// iterators have to be compared.
+template<bool SameLength, class... Iters>
+struct basic_zip_iterator {
+    using iterator_category = std::common_type_t<
+        std::random_access_iterator_tag, typename std::iterator_traits<Iters>::iterator_category...>;
+    using value_type = std::tuple<typename std::iterator_traits<Iters>::value_type...>;
+    using difference_type =
+        std::common_type_t<typename std::iterator_traits<Iters>::difference_type...>;
+    using reference = zip_reference<decltype(*std::declval<const Iters &>())...>;
+    using pointer = void;
+
+    constexpr basic_zip_iterator() = default;
+    constexpr basic_zip_iterator(Iters... its) : m_iters(its...) {}
+
+    constexpr auto operator++() -> basic_zip_iterator & {
+        std::apply([](auto &... it) { (++it, ...); }, m_iters);
+        return *this;
+    }
+
+    constexpr auto operator++(int) -> basic_zip_iterator {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
 
-        // If we are sure, that all iterators have the same "length", we can speed this up by just
-        // returning std::get<0>(m_iters) == std::get<0>(end.m_iters)
-        friend constexpr auto operator==(const zip_iterator &it1, const zip_iterator &it2) -> bool {
+    template<bool B = all_categories_v<std::bidirectional_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    constexpr auto operator--() -> basic_zip_iterator & {
+        std::apply([](auto &... it) { (--it, ...); }, m_iters);
+        return *this;
+    }
+
+    template<bool B = all_categories_v<std::bidirectional_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    constexpr auto operator--(int) -> basic_zip_iterator {
+        auto copy = *this;
+        --*this;
+        return copy;
+    }
+
+    constexpr auto operator*() const -> reference {
+        return std::apply([](auto &... it) { return reference(*it...); }, m_iters);
+    }
+
+    friend constexpr auto operator==(const basic_zip_iterator &it1, const basic_zip_iterator &it2)
+        -> bool {
+        if constexpr (SameLength) {
+            return std::get<0>(it1.m_iters) == std::get<0>(it2.m_iters);
+        } else {
             return comp<Iters...>(it1.m_iters, it2.m_iters);
         }
+    }
 
-        friend constexpr auto operator!=(const zip_iterator &it1, const zip_iterator &it2) -> bool {
-            return !(it1 == it2);
+    friend constexpr auto operator!=(const basic_zip_iterator &it1, const basic_zip_iterator &it2)
+        -> bool {
+        return !(it1 == it2);
+    }
+
+    // BEGIN Random access
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    constexpr auto operator+=(difference_type n) -> basic_zip_iterator & {
+        std::apply([n](auto &... it) { ((it += n), ...); }, m_iters);
+        return *this;
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    constexpr auto operator-=(difference_type n) -> basic_zip_iterator & {
+        return *this += -n;
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    constexpr auto operator[](difference_type n) const -> reference {
+        return *(*this + n);
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator+(basic_zip_iterator it, difference_type n) -> basic_zip_iterator {
+        return it += n;
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator+(difference_type n, basic_zip_iterator it) -> basic_zip_iterator {
+        return it += n;
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator-(basic_zip_iterator it, difference_type n) -> basic_zip_iterator {
+        return it -= n;
+    }
+
+    // Consistent with operator==, i.e. the distance to the end is the length of the shortest range.
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator-(const basic_zip_iterator &it1, const basic_zip_iterator &it2)
+        -> difference_type {
+        if constexpr (SameLength) {
+            return std::get<0>(it1.m_iters) - std::get<0>(it2.m_iters);
+        } else {
+            return shortest_distance<difference_type>(
+                it1.m_iters, it2.m_iters, std::index_sequence_for<Iters...>{});
         }
+    }
 
-      private:
-        std::tuple<Iters...> m_iters;
-    };
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator<(const basic_zip_iterator &it1, const basic_zip_iterator &it2)
+        -> bool {
+        return it1 - it2 < 0;
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator>(const basic_zip_iterator &it1, const basic_zip_iterator &it2)
+        -> bool {
+        return it2 < it1;
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator<=(const basic_zip_iterator &it1, const basic_zip_iterator &it2)
+        -> bool {
+        return !(it2 < it1);
+    }
+
+    template<bool B = all_categories_v<std::random_access_iterator_tag, Iters...>,
+             class = std::enable_if_t<B>>
+    friend constexpr auto operator>=(const basic_zip_iterator &it1, const basic_zip_iterator &it2)
+        -> bool {
+        return !(it1 < it2);
+    }
+    // END Random access
+
+    constexpr auto base() const noexcept -> const std::tuple<Iters...> & {
+        return m_iters;
+    }
+
+  private:
+    std::tuple<Iters...> m_iters;
+};
+
+// A zipped range that is only referenced, by its iterators. Lvalue containers are zipped like this, and
+// so are the sub-ranges of chunks.
+template<class Iter>
+struct borrowed_range {
+    constexpr borrowed_range(std::pair<Iter, Iter> iters) : first(iters.first), last(iters.second) {}
+
+    template<class Range>
+    constexpr borrowed_range(Range &r) : first(std::begin(r)), last(std::end(r)) {}
+
+    constexpr auto begin() const -> Iter {
+        return first;
+    }
+
+    constexpr auto end() const -> Iter {
+        return last;
+    }
+
+    Iter first;
+    Iter last;
+};
+
+// A temporary that was moved into the zip, like std::ranges::owning_view. The iterators are taken on
+// each call, so they refer to the range of the zip at hand, also after copies and moves. A zip does
+// not propagate its constness to the zipped ranges, so neither does this.
+template<class Range>
+struct owned_range {
+    template<class R>
+    constexpr owned_range(R &&r) : range(std::forward<R>(r)) {}
+
+    constexpr auto begin() const {
+        return std::begin(range);
+    }
+
+    constexpr auto end() const {
+        return std::end(range);
+    }
+
+    mutable Range range;
+};
+
+namespace {
+// A zip is parameterized with the iterator type of a referenced range and with owned_range<R> for a
+// range it owns.
+template<class Arg>
+struct range_holder {
+    using type = borrowed_range<Arg>;
+};
+
+template<class Range>
+struct range_holder<owned_range<Range>> {
+    using type = owned_range<Range>;
+};
+
+template<class Arg>
+using range_holder_t = typename range_holder<Arg>::type;
+
+template<class Arg>
+using range_iterator_t = decltype(std::declval<const range_holder_t<Arg> &>().begin());
+
+// The parameter of zip for an argument of type Range &&, so lvalues are referenced and rvalues owned.
+template<class Range>
+using zip_arg_t = std::conditional_t<std::is_lvalue_reference_v<Range>,
+                                     decltype(std::begin(std::declval<Range &>())),
+                                     owned_range<std::remove_cv_t<std::remove_reference_t<Range>>>>;
+}   // namespace
+
+// Zips lvalue containers by reference and holds temporaries by value, e.g. zip(compute(), out). A zip
+// of lvalues or iterator pairs only stores iterators, so it can be used in constant expressions.
+template<class... Args>
+struct zip {
+    using zip_iterator = basic_zip_iterator<false, range_iterator_t<Args>...>;
+
+    constexpr zip(std::pair<range_iterator_t<Args>, range_iterator_t<Args>>... iters) :
+            m_ranges{iters...} {}
+
+    template<class... containers, class = std::void_t<is_container_t<containers>...>,
+             class = std::enable_if_t<!is_self_v<zip, containers...>>>
+    constexpr zip(containers &&... cs) :
+            m_ranges{range_holder_t<Args>(std::forward<containers>(cs))...} {}
+
+    constexpr auto begin() const -> zip_iterator {
+        return std::apply([](const auto &... r) { return zip_iterator{r.begin()...}; }, m_ranges);
+    }
+
+    constexpr auto end() const -> zip_iterator {
+        return std::apply([](const auto &... r) { return zip_iterator{r.end()...}; }, m_ranges);
+    }
+
+  private:
+    std::tuple<range_holder_t<Args>...> m_ranges;
+};
+
+template<class... containers, class = std::void_t<is_container_t<containers>...>>
+zip(containers &&... cs)->zip<zip_arg_t<containers>...>;
+
+template<class... Iters>
+zip(std::pair<Iters, Iters>... iters)->zip<Iters...>;
+
+// Zip over ranges that have the same length, which is checked once on construction. Then the end check
+// only compares the first iterators and for_each is a counted loop, which the compiler can vectorize.
+template<class... Args>
+struct zip_same_length {
+    using zip_iterator = basic_zip_iterator<true, range_iterator_t<Args>...>;
+    using size_type = std::size_t;
+
+    constexpr zip_same_length(std::pair<range_iterator_t<Args>, range_iterator_t<Args>>... iters) :
+            m_ranges{iters...}, m_size(checked_length(m_ranges)) {}
+
+    // Temporaries are held like in zip.
+    template<class... containers, class = std::void_t<is_container_t<containers>...>,
+             class = std::enable_if_t<!is_self_v<zip_same_length, containers...>>>
+    constexpr zip_same_length(containers &&... cs) :
+            m_ranges{range_holder_t<Args>(std::forward<containers>(cs))...},
+            m_size(checked_length(m_ranges)) {}
 
     constexpr auto begin() const -> zip_iterator {
-        return m_begin;
+        return std::apply([](const auto &... r) { return zip_iterator{r.begin()...}; }, m_ranges);
     }
 
     constexpr auto end() const -> zip_iterator {
-        return m_end;
+        return std::apply([](const auto &... r) { return zip_iterator{r.end()...}; }, m_ranges);
+    }
+
+    constexpr auto size() const noexcept -> size_type {
+        return m_size;
+    }
+
+    // Calls f with the elements of each position as separate arguments.
+    template<class Func>
+    constexpr auto for_each(Func f) const -> Func {
+        return for_each_impl(f, std::index_sequence_for<Args...>{});
     }
 
   private:
-    zip_iterator m_begin;
-    const zip_iterator m_end;
+    static constexpr auto checked_length(const std::tuple<range_holder_t<Args>...> &ranges)
+        -> size_type {
+        const auto lengths = std::apply(
+            [](const auto &... r) {
+                return std::array<size_type, sizeof...(Args)>{
+                    static_cast<size_type>(std::distance(r.begin(), r.end()))...};
+            },
+            ranges);
+        for (size_type length: lengths) {
+            if (length != lengths[0]) {
+                throw std::invalid_argument{"Zipped ranges do not have the same length"};
+            }
+        }
+        return lengths[0];
+    }
+
+    template<class Func, std::size_t... I>
+    constexpr auto for_each_impl(Func &f, std::index_sequence<I...> /*unused*/) const -> Func {
+        auto its = begin().base();
+        for (size_type n = 0; n != m_size; ++n) {
+            f(*std::get<I>(its)...);
+            (++std::get<I>(its), ...);
+        }
+        return f;
+    }
+
+    std::tuple<range_holder_t<Args>...> m_ranges;
+    size_type m_size;
 };
 
 template<class... containers, class = std::void_t<is_container_t<containers>...>>
-zip(containers &... cs)->zip<decltype(cs.begin())...>;
+zip_same_length(containers &&... cs)->zip_same_length<zip_arg_t<containers>...>;
 
-// Class that helps with having the index in a ranged-for-loop
+template<class... Iters>
+zip_same_length(std::pair<Iters, Iters>... iters)->zip_same_length<Iters...>;
+
+// Class that helps with having the index in a ranged-for-loop. Without a bound it counts up to
+// Limits::max(), a bounded iota(first, last, step) is a sized range of first, first + step, ... that
+// stops before last.
 template<class IntegerT = std::size_t, class Limits = std::numeric_limits<IntegerT>>
 struct iota {
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    // Wide enough for the number of steps between any two values of IntegerT.
+    using count_type = std::make_unsigned_t<std::common_type_t<IntegerT, std::size_t>>;
+
     constexpr iota() = default;
     constexpr iota(IntegerT i) : start{i} {}
 
+    // Throws std::invalid_argument unless step is positive and first <= last.
+    constexpr iota(IntegerT first, IntegerT last, difference_type step_size = 1) :
+            start{first}, step{step_size}, length{count(first, last, step_size)} {}
+
+    // Iterators are compared by their position, i.e. the number of steps from the start, since the
+    // value after the last one may wrap around, e.g. for iota<std::uint8_t>(0, 255, 2).
     struct iota_iter {
-        constexpr iota_iter(IntegerT i) : cur_index{i} {}
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = IntegerT;
+        using difference_type = std::ptrdiff_t;
+        using reference = IntegerT;
+        using pointer = void;
+
+        constexpr iota_iter() = default;
+        constexpr iota_iter(IntegerT i, difference_type step_size = 1, count_type position = 0) :
+                cur_index{i}, pos{position}, step{step_size} {}
 
-        constexpr auto operator*() const -> const IntegerT & {
+        constexpr auto operator*() const -> reference {
             return cur_index;
         }
 
-        constexpr auto operator*() -> IntegerT & {
-            return cur_index;
+        constexpr auto operator[](difference_type n) const -> reference {
+            return *(*this + n);
         }
 
         constexpr auto operator++() -> iota_iter & {
-            ++cur_index;
-            return *this;
+            return *this += 1;
         }
 
         constexpr auto operator++(int) -> iota_iter {
-            return iota_iter{cur_index++};
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator--() -> iota_iter & {
+            return *this -= 1;
+        }
+
+        constexpr auto operator--(int) -> iota_iter {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        // Unsigned arithmetic, so stepping past the end wraps instead of overflowing.
+        constexpr auto operator+=(difference_type n) -> iota_iter & {
+            const auto steps = static_cast<count_type>(n);
+            cur_index = static_cast<IntegerT>(static_cast<count_type>(cur_index) +
+                                              steps * static_cast<count_type>(step));
+            pos += steps;
+            return *this;
+        }
+
+        constexpr auto operator-=(difference_type n) -> iota_iter & {
+            return *this += -n;
+        }
+
+        friend constexpr auto operator+(iota_iter it, difference_type n) -> iota_iter {
+            return it += n;
+        }
+
+        friend constexpr auto operator+(difference_type n, iota_iter it) -> iota_iter {
+            return it += n;
+        }
+
+        friend constexpr auto operator-(iota_iter it, difference_type n) -> iota_iter {
+            return it -= n;
+        }
+
+        // Saturates, since the distance to the unbounded end does not fit into difference_type.
+        friend constexpr auto operator-(const iota_iter &it1, const iota_iter &it2) -> difference_type {
+            constexpr auto max = static_cast<count_type>(std::numeric_limits<difference_type>::max());
+            if (it2.pos <= it1.pos) {
+                const count_type diff = it1.pos - it2.pos;
+                return static_cast<difference_type>(diff > max ? max : diff);
+            }
+            return -(it2 - it1);
         }
 
         friend constexpr auto operator==(const iota_iter &it1, const iota_iter &it2) -> bool {
-            return it1.cur_index == it2.cur_index;
+            return it1.pos == it2.pos;
         }
 
         friend constexpr auto operator!=(const iota_iter &it1, const iota_iter &it2) -> bool {
             return !(it1 == it2);
         }
 
+        friend constexpr auto operator<(const iota_iter &it1, const iota_iter &it2) -> bool {
+            return it1.pos < it2.pos;
+        }
+
+        friend constexpr auto operator>(const iota_iter &it1, const iota_iter &it2) -> bool {
+            return it2 < it1;
+        }
+
+        friend constexpr auto operator<=(const iota_iter &it1, const iota_iter &it2) -> bool {
+            return !(it2 < it1);
+        }
+
+        friend constexpr auto operator>=(const iota_iter &it1, const iota_iter &it2) -> bool {
+            return !(it1 < it2);
+        }
+
       private:
-        IntegerT cur_index;
+        IntegerT cur_index{};
+        count_type pos = 0;
+        difference_type step = 1;
     };
 
     constexpr auto begin() const -> iota_iter {
-        return iota_iter{start};
+        return iota_iter{start, step};
     }
 
     constexpr auto end() const -> iota_iter {
-        return iota_iter{Limits::max()};
+        const auto stop = static_cast<count_type>(start) + length * static_cast<count_type>(step);
+        return iota_iter{static_cast<IntegerT>(stop), step, length};
+    }
+
+    constexpr auto size() const -> size_type {
+        return static_cast<size_type>(length);
     }
 
   private:
+    // The number of steps from first that stay below last, computed without overflow.
+    static constexpr auto count(IntegerT first, IntegerT last, difference_type step_size)
+        -> count_type {
+        if (step_size <= 0 || last < first) {
+            throw std::invalid_argument{"iota needs a positive step and first <= last"};
+        }
+        const auto distance = static_cast<count_type>(static_cast<count_type>(last) -
+                                                      static_cast<count_type>(first));
+        const auto steps = static_cast<count_type>(step_size);
+        return distance / steps + (distance % steps != 0 ? 1 : 0);
+    }
+
     IntegerT start{};
+    difference_type step = 1;
+    count_type length = count(start, Limits::max(), 1);
 };
 
+namespace {
+// Poor man's concept for containers with a size member, others are counted.
+template<class Container, class = void>
+constexpr bool has_size_v = false;
+
+template<class Container>
+constexpr bool
+    has_size_v<Container, std::void_t<decltype(std::declval<Container &>().size())>> = true;
+
+template<class Container>
+constexpr auto range_size(Container &c) -> std::size_t {
+    if constexpr (has_size_v<Container>) {
+        return static_cast<std::size_t>(c.size());
+    } else {
+        return static_cast<std::size_t>(std::distance(std::begin(c), std::end(c)));
+    }
+}
+}   // namespace
+
+// The index is bounded by the size of the container, so the length of the loop is known. A temporary
+// container is held by the returned zip.
 template<class Container, class IntegerT = std::size_t>
-constexpr auto with_index(Container &c, IntegerT start = {})
-    -> zip<typename iota<IntegerT>::iota_iter, decltype(std::begin(c))> {
-    iota tmp{start};   // Does have to outlive the function
-    return zip{tmp, c};
+constexpr auto with_index(Container &&c, IntegerT start = {})
+    -> zip<typename iota<IntegerT>::iota_iter, zip_arg_t<Container>> {
+    // Zipped by its iterators, which carry the index themselves, so it need not outlive this function
+    iota<IntegerT> indices{start, static_cast<IntegerT>(start + range_size(c))};
+    return {indices, std::forward<Container>(c)};
+}
+
+// The reverse of zip, an output iterator that writes each element of an assigned tuple (or pair or
+// zip_reference) to its own output iterator, e.g. back_inserters of separate containers. Rvalue tuples
+// are moved element by element, so move-only types work.
+template<class... Outs>
+class unzip_iterator {
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    constexpr unzip_iterator(Outs... outs) : m_outs(outs...) {}
+
+    template<class Tuple,
+             class = std::enable_if_t<
+                 !std::is_same_v<std::remove_cv_t<std::remove_reference_t<Tuple>>, unzip_iterator>>>
+    constexpr auto operator=(Tuple &&t) -> unzip_iterator & {
+        static_assert(std::tuple_size_v<std::remove_reference_t<Tuple>> == sizeof...(Outs),
+                      "Every element needs its own output iterator.");
+        assign(std::forward<Tuple>(t), std::index_sequence_for<Outs...>{});
+        return *this;
+    }
+
+    constexpr auto operator*() -> unzip_iterator & {
+        return *this;
+    }
+
+    constexpr auto operator++() -> unzip_iterator & {
+        return *this;
+    }
+
+    constexpr auto operator++(int) -> unzip_iterator & {
+        return *this;
+    }
+
+    // The output iterators after the last write.
+    constexpr auto base() const -> const std::tuple<Outs...> & {
+        return m_outs;
+    }
+
+  private:
+    template<class Tuple, std::size_t... I>
+    constexpr void assign(Tuple &&t, std::index_sequence<I...> /*unused*/) {
+        ((*std::get<I>(m_outs) = std::get<I>(std::forward<Tuple>(t)), ++std::get<I>(m_outs)), ...);
+    }
+
+    std::tuple<Outs...> m_outs;
+};
+
+template<class... Outs>
+constexpr auto unzip(Outs... outs) -> unzip_iterator<Outs...> {
+    return unzip_iterator<Outs...>{outs...};
+}
+
+// BEGIN Parallel arrays
+// Reorders each of the columns, such that the element at position i is the one that was at perm[i]
+// before. This is done in place by following the cycles of the permutation, moving a whole row, i.e.
+// the element of each column at that position, per step. Besides the row in flight, only a bit per
+// position is needed to mark the finished ones. Elements are only moved, so move-only types work. If
+// perm is not a permutation, std::invalid_argument is thrown and the columns are left in some order.
+// The sorts below permute through buffers instead, which is faster if there is memory for them.
+template<class Perm, class... Columns>
+void apply_permutation(const Perm &perm, Columns &... columns) {
+    const std::size_t size = range_size(perm);
+    if (((range_size(columns) != size) || ...)) {
+        throw std::invalid_argument{"Permutation and columns differ in size"};
+    }
+
+    const auto perm_first = std::begin(perm);
+    const std::tuple firsts{std::begin(columns)...};
+    auto at = [&firsts](std::size_t pos) {
+        return std::apply(
+            [pos](const auto &... first) {
+                return std::tie(first[static_cast<std::ptrdiff_t>(pos)]...);
+            },
+            firsts);
+    };
+    auto take_row = [](auto &&from) {
+        return std::apply(
+            [](auto &... f) {
+                return std::tuple<std::remove_reference_t<decltype(f)>...>{std::move(f)...};
+            },
+            from);
+    };
+    auto move_row = [](auto &&from, auto &&to) {
+        std::apply([&to](auto &... f) { to = std::forward_as_tuple(std::move(f)...); }, from);
+    };
+
+    std::vector<bool> done(size);
+    for (std::size_t start = 0; start != size; ++start) {
+        if (done[start]) {
+            continue;
+        }
+
+        auto row = take_row(at(start));
+        std::size_t pos = start;
+        for (;;) {
+            done[pos] = true;
+            const auto from = static_cast<std::size_t>(perm_first[static_cast<std::ptrdiff_t>(pos)]);
+            if (from == start) {
+                break;
+            }
+            if (from >= size || done[from]) {
+                move_row(row, at(pos));
+                throw std::invalid_argument{"Not a permutation"};
+            }
+            move_row(at(from), at(pos));
+            pos = from;
+        }
+        move_row(row, at(pos));
+    }
+}
+
+namespace {
+template<class Keys, class... Values>
+void check_columns(const Keys &keys, const Values &... values) {
+    const std::size_t size = range_size(keys);
+    if (((range_size(values) != size) || ...)) {
+        throw std::invalid_argument{"Keys and values differ in size"};
+    }
+}
+
+// Like apply_permutation for a single column, but through a buffer of the whole column. The reads of
+// the buffered copy are independent of each other, while following a cycle has to wait for each read
+// before it knows the next position. Used for fewer than min_bucketed_columns columns and for elements
+// whose moves may throw.
+template<class Perm, class Column>
+void gather(const Perm &perm, Column &column) {
+    using value_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(column))>>;
+    const auto first = std::begin(column);
+
+    std::vector<value_t> buffer;
+    buffer.reserve(range_size(perm));
+    for (const auto pos: perm) {
+        buffer.push_back(std::move(first[static_cast<std::ptrdiff_t>(pos)]));
+    }
+    std::move(buffer.begin(), buffer.end(), first);
+}
+
+// Gathering reads each column at random positions, so nearly every read misses the cache once a column
+// does not fit into it. A bucketed permutation moves the rows in two passes instead: first in order of
+// their positions into one bucket per block of destinations, then from the buckets into their block.
+// Both passes read sequentially, the first one writes to one position per bucket, the second one only
+// within a block, which is small enough to stay in the cache. The schedule only depends on the
+// permutation, so it is computed once for all columns. Index is std::uint32_t if the columns are short
+// enough, which halves the memory traffic for the schedule.
+template<class Index>
+struct bucketed_permutation {
+    std::vector<Index> slots;     // The slot in the buckets of the row at each position
+    std::vector<Index> targets;   // The destination of the row in each slot
+};
+
+template<class Column>
+using column_value_t =
+    std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<Column &>()))>>;
+
+// The buckets are uninitialized memory, so a column could not be restored if a move throws.
+template<class T>
+inline constexpr bool is_bucketable_v =
+    std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>;
+
+// A block of destinations should fit into a typical L2 cache, but there should not be more buckets than
+// write streams the cache can follow, so large columns get larger blocks.
+inline constexpr std::size_t bucket_block_bytes = std::size_t{1} << 18;
+inline constexpr std::size_t max_buckets = 1024;
+
+template<class Index, class Perm>
+auto make_bucketed_permutation(const Perm &perm, std::size_t element_size)
+    -> bucketed_permutation<Index> {
+    const std::size_t size = range_size(perm);
+    // Blocks are a power of two long, so the block of a position is a shift, not a division.
+    unsigned shift = 0;
+    while ((std::size_t{1} << shift) * element_size < bucket_block_bytes ||
+           (size >> shift) >= max_buckets) {
+        ++shift;
+    }
+    const std::size_t block = std::size_t{1} << shift;
+    const std::size_t buckets = (size + block - 1) >> shift;
+
+    // Every block of positions and every block of destinations has exactly block rows, except the last
+    // one, so the buckets start at multiples of block.
+    std::vector<std::size_t> starts(buckets);
+    for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+        starts[bucket] = bucket * block;
+    }
+
+    // Inverting the permutation directly would scatter at random, so the (position, destination) pairs
+    // are bucketed by the block of the position first, the same way the columns are.
+    auto offsets = starts;
+    std::vector<std::pair<Index, Index>> by_position(size);
+    Index to = 0;
+    for (const auto from: perm) {
+        const auto pos = static_cast<Index>(from);
+        by_position[offsets[pos >> shift]++] = {pos, to++};
+    }
+
+    // The pairs are visited block by block of positions, so the slots of a bucket are filled in about
+    // the order of the positions and the first pass of permute_bucketed writes each bucket nearly
+    // sequentially.
+    offsets = starts;
+    bucketed_permutation<Index> ret{std::vector<Index>(size), std::vector<Index>(size)};
+    for (const auto &[pos, destination]: by_position) {
+        const auto slot = static_cast<Index>(offsets[destination >> shift]++);
+        ret.slots[pos] = slot;
+        ret.targets[slot] = destination;
+    }
+    return ret;
+}
+
+// Reorders a column according to the schedule, storage has room for one element per row.
+template<class Index, class Column>
+void permute_bucketed(const bucketed_permutation<Index> &schedule, Column &column, void *storage) {
+    using value_t = column_value_t<Column>;
+    static_assert(is_bucketable_v<value_t>, "Columns whose moves may throw have to be gathered.");
+    const auto first = std::begin(column);
+    const std::size_t size = schedule.slots.size();
+
+    auto *buckets = static_cast<value_t *>(storage);
+    for (std::size_t pos = 0; pos < size; ++pos) {
+        ::new (static_cast<void *>(buckets + schedule.slots[pos]))
+            value_t(std::move(first[static_cast<std::ptrdiff_t>(pos)]));
+    }
+    for (std::size_t slot = 0; slot < size; ++slot) {
+        value_t *bucketed = std::launder(buckets + slot);
+        first[static_cast<std::ptrdiff_t>(schedule.targets[slot])] = std::move(*bucketed);
+        bucketed->~value_t();
+    }
+}
+
+// Building the schedule takes about as long as gathering one or two columns of doubles, while a column
+// is permuted through the buckets in about half the time it takes to gather it, see bench.cpp. So fewer
+// columns are gathered.
+inline constexpr std::size_t min_bucketed_columns = 3;
+
+// Permutes the columns that can be bucketed and gathers the others.
+template<class Index, class Perm, class... Columns>
+void permute_columns(const Perm &perm, Columns &... columns) {
+    // One buffer for the buckets of all columns, so its pages are only faulted in once.
+    using bucket_t = std::aligned_union_t<0, column_value_t<Columns>...>;
+    const auto schedule = make_bucketed_permutation<Index>(perm, sizeof(bucket_t));
+    const std::unique_ptr<bucket_t[]> storage{new bucket_t[range_size(perm)]};
+    (
+        [&] {
+            if constexpr (is_bucketable_v<column_value_t<Columns>>) {
+                permute_bucketed(schedule, columns, storage.get());
+            } else {
+                gather(perm, columns);
+            }
+        }(),
+        ...);
+}
+
+// The keys with their positions, sorted on their own and then written back, so that the sort does not
+// jump between the columns.
+template<class Keys>
+auto keyed_positions(const Keys &keys) {
+    using key_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(keys))>>;
+    std::vector<std::pair<key_t, std::size_t>> ret;
+    ret.reserve(range_size(keys));
+    std::size_t pos = 0;
+    for (const auto &key: keys) {
+        ret.emplace_back(key, pos++);
+    }
+    return ret;
+}
+
+template<class Keyed, class Keys, class... Values>
+void write_back(Keyed &keyed, Keys &keys, Values &... values) {
+    std::vector<std::size_t> perm;
+    perm.reserve(keyed.size());
+    auto key = std::begin(keys);
+    for (auto &[k, pos]: keyed) {
+        *key++ = std::move(k);
+        perm.push_back(pos);
+    }
+    constexpr auto bucketable =
+        (std::size_t{0} + ... + std::size_t{is_bucketable_v<column_value_t<Values>>});
+    if constexpr (bucketable >= min_bucketed_columns) {
+        if (perm.size() <= std::numeric_limits<std::uint32_t>::max()) {
+            permute_columns<std::uint32_t>(perm, values...);
+        } else {
+            permute_columns<std::size_t>(perm, values...);
+        }
+    } else {
+        (gather(perm, values), ...);
+    }
+}
+
+template<bool Stable, class Keyed>
+void sort_keyed(Keyed &keyed) {
+    auto by_key = [](const auto &left, const auto &right) { return left.first < right.first; };
+    if constexpr (Stable) {
+        std::stable_sort(keyed.begin(), keyed.end(), by_key);
+    } else {
+        std::sort(keyed.begin(), keyed.end(), by_key);
+    }
+}
+}   // namespace
+
+// Sorts keys with operator< and reorders the values the same way, like the rows of a table. All columns
+// need the size of keys, otherwise std::invalid_argument is thrown before anything is reordered.
+template<class Keys, class... Values>
+void sort_by_key(Keys &keys, Values &... values) {
+    check_columns(keys, values...);
+    auto keyed = keyed_positions(keys);
+    sort_keyed<false>(keyed);
+    write_back(keyed, keys, values...);
+}
+
+// Like sort_by_key, but rows with equal keys keep their order.
+template<class Keys, class... Values>
+void stable_sort_by_key(Keys &keys, Values &... values) {
+    check_columns(keys, values...);
+    auto keyed = keyed_positions(keys);
+    sort_keyed<true>(keyed);
+    write_back(keyed, keys, values...);
+}
+
+// Stable sort by integer keys, a least significant digit radix sort with one pass per byte, passes are
+// skipped if all keys have the same byte.
+template<class Keys, class... Values>
+void radix_sort_by_key(Keys &keys, Values &... values) {
+    using key_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(keys))>>;
+    static_assert(std::is_integral_v<key_t> && !std::is_same_v<key_t, bool>,
+                  "Radix sort needs integer keys, use stable_sort_by_key for bool.");
+    using bits_t = std::make_unsigned_t<key_t>;
+
+    // Flipping the sign bit orders negative numbers before positive ones.
+    constexpr auto flip = std::is_signed_v<key_t>
+                              ? static_cast<bits_t>(bits_t{1} << (sizeof(bits_t) * 8 - 1))
+                              : bits_t{0};
+
+    check_columns(keys, values...);
+    auto keyed = keyed_positions(keys);
+    std::vector<std::pair<bits_t, std::size_t>> from(keyed.size());
+    std::transform(keyed.begin(), keyed.end(), from.begin(), [flip](const auto &k) {
+        return std::pair{static_cast<bits_t>(static_cast<bits_t>(k.first) ^ flip), k.second};
+    });
+    std::vector<std::pair<bits_t, std::size_t>> to(from.size());
+
+    for (std::size_t shift = 0; shift < sizeof(bits_t) * 8; shift += 8) {
+        std::size_t offsets[257] = {};
+        for (const auto &k: from) {
+            ++offsets[((k.first >> shift) & 0xff) + 1];
+        }
+        if (std::find(std::begin(offsets), std::end(offsets), from.size()) != std::end(offsets)) {
+            continue;
+        }
+        for (std::size_t digit = 1; digit < 257; ++digit) {
+            offsets[digit] += offsets[digit - 1];
+        }
+        for (const auto &k: from) {
+            to[offsets[(k.first >> shift) & 0xff]++] = k;
+        }
+        from.swap(to);
+    }
+
+    std::transform(from.begin(), from.end(), keyed.begin(), [flip](const auto &k) {
+        return std::pair{static_cast<key_t>(static_cast<bits_t>(k.first ^ flip)), k.second};
+    });
+    write_back(keyed, keys, values...);
+}
+// END Parallel arrays
+
+namespace {
+template<template<class...> class Zip, class... Iters, std::size_t... I>
+auto sub_zip(const std::tuple<Iters...> &first, const std::tuple<Iters...> &last,
+             std::index_sequence<I...> /*unused*/) -> Zip<Iters...> {
+    return Zip<Iters...>{std::pair<Iters, Iters>{std::get<I>(first), std::get<I>(last)}...};
+}
+}   // namespace
+
+// Chunks are a multiple of this many elements long, so they start at a cache line if the ranges do.
+inline constexpr std::size_t chunk_granularity = 64;
+
+// Splits a zip (or zip_same_length) of random access iterators into at most n contiguous zips. Zipped
+// iotas, like the index of with_index, are advanced with the others, so they keep the global index. The
+// chunks refer to the ranges of z, so they must not outlive it if it holds temporaries.
+template<template<class...> class Zip, class... Args,
+         class Chunk = Zip<range_iterator_t<Args>...>>
+auto chunks(const Zip<Args...> &z, std::size_t n) -> std::vector<Chunk> {
+    static_assert(all_categories_v<std::random_access_iterator_tag, range_iterator_t<Args>...>,
+                  "Only ranges of random access iterators can be split.");
+
+    const auto length = static_cast<std::size_t>(z.end() - z.begin());
+    const std::size_t parts = std::max<std::size_t>(1, n);
+    std::size_t chunk_length = (length + parts - 1) / parts;
+    chunk_length = (chunk_length + chunk_granularity - 1) / chunk_granularity * chunk_granularity;
+
+    std::vector<Chunk> ret;
+    for (std::size_t first = 0; first < length; first += chunk_length) {
+        const auto begin = z.begin() + first;
+        const auto end = length - first <= chunk_length ? z.end() : begin + chunk_length;
+        ret.push_back(sub_zip<Zip>(begin.base(), end.base(), std::index_sequence_for<Args...>{}));
+    }
+    return ret;
+}
+
+// Calls f(*it) for each position of the zip like std::for_each, but on chunks of the range in parallel.
+// Each thread gets its own copy of f. The first exception thrown by f is rethrown after all threads
+// finished.
+template<class Zip, class Func>
+void parallel_for_each(const Zip &z, Func f,
+                       std::size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+    const auto parts = chunks(z, threads);
+    std::vector<std::exception_ptr> errors(parts.size());
+
+    auto run = [&parts, &errors, &f](std::size_t part) noexcept {
+        try {
+            std::for_each(parts[part].begin(), parts[part].end(), f);
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t part = 1; part < parts.size(); ++part) {
+        try {
+            workers.emplace_back(run, part);
+        } catch (...) {
+            run(part);   // Could not start a thread, so do it ourselves
+        }
+    }
+    if (!parts.empty()) {
+        run(0);
+    }
+
+    for (auto &worker: workers) {
+        worker.join();
+    }
+    for (const auto &error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// A fixed number of values of T, like a SIMD register. The operations work lane by lane in plain loops
+// of constant length, which the compiler turns into vector instructions. Scalars are broadcast
+// implicitly, so expressions like a * x + y work with a scalar a.
+template<class T, std::size_t W>
+struct pack {
+    using value_type = T;
+    static constexpr std::size_t width = W;
+
+    constexpr pack() = default;
+    constexpr pack(T value) noexcept {
+        for (auto &lane: lanes) {
+            lane = value;
+        }
+    }
+
+    constexpr auto operator[](std::size_t i) noexcept -> T & {
+        return lanes[i];
+    }
+
+    constexpr auto operator[](std::size_t i) const noexcept -> const T & {
+        return lanes[i];
+    }
+
+    // BEGIN Arithmetic
+    constexpr auto operator+=(const pack &other) noexcept -> pack & {
+        for (std::size_t i = 0; i < W; ++i) {
+            lanes[i] += other.lanes[i];
+        }
+        return *this;
+    }
+
+    constexpr auto operator-=(const pack &other) noexcept -> pack & {
+        for (std::size_t i = 0; i < W; ++i) {
+            lanes[i] -= other.lanes[i];
+        }
+        return *this;
+    }
+
+    constexpr auto operator*=(const pack &other) noexcept -> pack & {
+        for (std::size_t i = 0; i < W; ++i) {
+            lanes[i] *= other.lanes[i];
+        }
+        return *this;
+    }
+
+    constexpr auto operator/=(const pack &other) noexcept -> pack & {
+        for (std::size_t i = 0; i < W; ++i) {
+            lanes[i] /= other.lanes[i];
+        }
+        return *this;
+    }
+
+    friend constexpr auto operator-(pack p) noexcept -> pack {
+        for (auto &lane: p.lanes) {
+            lane = -lane;
+        }
+        return p;
+    }
+
+    friend constexpr auto operator+(pack left, const pack &right) noexcept -> pack {
+        return left += right;
+    }
+
+    friend constexpr auto operator-(pack left, const pack &right) noexcept -> pack {
+        return left -= right;
+    }
+
+    friend constexpr auto operator*(pack left, const pack &right) noexcept -> pack {
+        return left *= right;
+    }
+
+    friend constexpr auto operator/(pack left, const pack &right) noexcept -> pack {
+        return left /= right;
+    }
+
+    // Horizontal sum of all lanes.
+    friend constexpr auto sum(const pack &p) noexcept -> T {
+        T ret{};
+        for (const auto &lane: p.lanes) {
+            ret += lane;
+        }
+        return ret;
+    }
+    // END Arithmetic
+
+    T lanes[W]{};
+};
+
+// Lanes that fit into a 256 bit register.
+template<class T>
+inline constexpr std::size_t default_width = std::max<std::size_t>(1, 32 / sizeof(T));
+
+namespace {
+template<std::size_t W, class Iter>
+constexpr auto load_pack(const Iter &it) -> pack<typename std::iterator_traits<Iter>::value_type, W> {
+    pack<typename std::iterator_traits<Iter>::value_type, W> ret;
+    for (std::size_t i = 0; i < W; ++i) {
+        ret[i] = *(it + static_cast<std::ptrdiff_t>(i));
+    }
+    return ret;
+}
+
+template<std::size_t W, class Iter, class T>
+constexpr void store_pack(const pack<T, W> &p, const Iter &it) {
+    static_assert(std::is_assignable_v<decltype(*std::declval<const Iter &>()), const T &>,
+                  "packs can only be stored back to writable ranges");
+    for (std::size_t i = 0; i < W; ++i) {
+        *(it + static_cast<std::ptrdiff_t>(i)) = p[i];
+    }
+}
+
+template<std::size_t I, std::size_t... Stored>
+inline constexpr bool is_stored_v = ((I == Stored) || ...);
+
+// The tail gets references to the elements of the stored ranges and copies of the others.
+template<class Iter, bool Stored>
+using tail_arg_t = std::conditional_t<Stored, typename std::iterator_traits<Iter>::reference,
+                                      typename std::iterator_traits<Iter>::value_type>;
+
+template<std::size_t W, std::size_t... Stored, class Func, class Tail, class... Iters, std::size_t... I>
+constexpr void for_each_batch_impl(const std::tuple<Iters...> &its, std::ptrdiff_t length, Func &f,
+                                   Tail &tail, std::index_sequence<I...> /*unused*/) {
+    static_assert(((Stored < sizeof...(Iters)) && ...), "stored range out of range");
+    std::ptrdiff_t pos = 0;
+    for (; length - pos >= static_cast<std::ptrdiff_t>(W); pos += static_cast<std::ptrdiff_t>(W)) {
+        std::tuple<pack<typename std::iterator_traits<Iters>::value_type, W>...> packs{
+            load_pack<W>(std::get<I>(its) + pos)...};
+        f(std::get<I>(packs)...);
+        (
+            [&] {
+                if constexpr (is_stored_v<I, Stored...>) {
+                    store_pack<W>(std::get<I>(packs), std::get<I>(its) + pos);
+                }
+            }(),
+            ...);
+    }
+    for (; pos != length; ++pos) {
+        std::tuple<tail_arg_t<Iters, is_stored_v<I, Stored...>>...> elements{
+            *(std::get<I>(its) + pos)...};
+        std::apply(tail, elements);
+    }
+}
+}   // namespace
+
+// Calls f with one pack of W values per zipped range for each full batch and tail with the single
+// elements of the remaining positions. Only the ranges at the positions Stored are written, their packs
+// after f returns and their elements through references passed to tail, the other ranges are passed to
+// tail as copies. E.g. for_each_batch<8, 1>(zip(x, y), f) for y += a * x. The ranges have to be random
+// access, but need not be contiguous.
+template<std::size_t W, std::size_t... Stored, class Zip, class Func, class Tail>
+constexpr void for_each_batch(const Zip &z, Func f, Tail tail) {
+    using iters = std::remove_cv_t<std::remove_reference_t<decltype(z.begin().base())>>;
+    constexpr auto indices = std::make_index_sequence<std::tuple_size_v<iters>>{};
+    for_each_batch_impl<W, Stored...>(z.begin().base(), z.end() - z.begin(), f, tail, indices);
+}
+
+// Uses f for the tail as well, so it has to be generic, e.g. take its arguments as const auto &.
+template<std::size_t W, std::size_t... Stored, class Zip, class Func>
+constexpr void for_each_batch(const Zip &z, Func f) {
+    for_each_batch<W, Stored...>(z, f, f);
 }
 
 }   // namespace zip_iter
 
+namespace std {
+// Makes zip_reference usable in structured bindings.
+template<class... Refs>
+struct tuple_size<zip_iter::zip_reference<Refs...>> : tuple_size<tuple<Refs...>> {};
+
+template<size_t I, class... Refs>
+struct tuple_element<I, zip_iter::zip_reference<Refs...>> : tuple_element<I, tuple<Refs...>> {};
+}   // namespace std
+
 #endif   // ZIP_HPP